@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/loadcell.hpp>
+
+#include <components/openmw-mp/CellIndex.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // A persistent world of 2,000 cells, with a 42 by 42 block of exteriors and the rest interiors
+    constexpr int sGridSize = 42;
+    constexpr int sCellCount = 2000;
+    constexpr int sPlayerCount = 64;
+
+    struct World
+    {
+        std::deque<ESM::Cell> mCells;
+        std::deque<ESM::Cell*> mCellList;
+        CellIndex<ESM::Cell> mCellIndex;
+
+        World()
+        {
+            for (int i = 0; i < sCellCount; i++)
+            {
+                ESM::Cell cell;
+                cell.blank();
+
+                if (i < sGridSize * sGridSize)
+                {
+                    cell.mData.mFlags = 0;
+                    cell.mData.mX = i % sGridSize - sGridSize / 2;
+                    cell.mData.mY = i / sGridSize - sGridSize / 2;
+                }
+                else
+                {
+                    cell.mData.mFlags = ESM::Cell::Interior;
+                    cell.mName = "Interior cell number " + std::to_string(i);
+                }
+
+                mCells.push_back(cell);
+                mCellList.push_back(&mCells.back());
+                mCellIndex.add(mCells.back(), &mCells.back());
+            }
+        }
+
+        // How CellController used to look cells up
+        ESM::Cell *getByLinearScan(const ESM::Cell &esmCell)
+        {
+            std::deque<ESM::Cell*>::iterator it;
+
+            if (esmCell.isExterior())
+            {
+                int x = esmCell.mData.mX;
+                int y = esmCell.mData.mY;
+
+                it = std::find_if(mCellList.begin(), mCellList.end(), [x, y](const ESM::Cell *c)
+                {
+                    return c->mData.mX == x && c->mData.mY == y;
+                });
+            }
+            else
+            {
+                std::string cellName = esmCell.mName;
+
+                it = std::find_if(mCellList.begin(), mCellList.end(), [cellName](const ESM::Cell *c)
+                {
+                    return c->mName == cellName;
+                });
+            }
+
+            return it != mCellList.end() ? *it : nullptr;
+        }
+    };
+
+    // Players wander between neighbouring exteriors and occasionally enter an interior, with every
+    // step looking up the cell they are in, as an actor packet about it would
+    std::vector<ESM::Cell> makeRoamingPath(const World &world, std::size_t length)
+    {
+        std::minstd_rand random(42);
+        std::vector<ESM::Cell> path;
+        path.reserve(length);
+
+        std::vector<int> positions(sPlayerCount);
+        for (auto &position : positions)
+            position = random() % (sGridSize * sGridSize);
+
+        for (std::size_t i = 0; i < length; i++)
+        {
+            int &position = positions[i % sPlayerCount];
+
+            if (random() % 10 == 0)
+                path.push_back(world.mCells[sGridSize * sGridSize + random() % (sCellCount - sGridSize * sGridSize)]);
+            else
+            {
+                int x = std::min(std::max(position % sGridSize + (int) (random() % 3) - 1, 0), sGridSize - 1);
+                int y = std::min(std::max(position / sGridSize + (int) (random() % 3) - 1, 0), sGridSize - 1);
+                position = y * sGridSize + x;
+                path.push_back(world.mCells[position]);
+            }
+        }
+
+        return path;
+    }
+
+    void lookupByLinearScan(benchmark::State& state)
+    {
+        World world;
+        std::vector<ESM::Cell> path = makeRoamingPath(world, 4096);
+        std::size_t step = 0;
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(world.getByLinearScan(path[step]));
+            step = (step + 1) % path.size();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void lookupByIndex(benchmark::State& state)
+    {
+        World world;
+        std::vector<ESM::Cell> path = makeRoamingPath(world, 4096);
+        std::size_t step = 0;
+
+        while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(world.mCellIndex.get(path[step]));
+            step = (step + 1) % path.size();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(lookupByLinearScan);
+BENCHMARK(lookupByIndex);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/cellref.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // A busy cell of 3,000 references, like a large city exterior, where a third of them were placed
+    // by the server and only have an mpNum
+    //
+    // CellStore is part of the client and needs a whole world to be loaded, so this only compares the two ways
+    // of searching a list of references on their own, not CellStore::searchExact itself
+    constexpr int sRefCount = 3000;
+    constexpr int sPlacedCount = 1000;
+
+    uint64_t getKey(unsigned int refNum, unsigned int mpNum)
+    {
+        return (static_cast<uint64_t>(refNum) << 32) | mpNum;
+    }
+
+    struct Cell
+    {
+        std::vector<ESM::CellRef> mRefs;
+        std::unordered_multimap<uint64_t, std::size_t> mIndex;
+
+        Cell()
+        {
+            mRefs.reserve(sRefCount);
+
+            for (int i = 0; i < sRefCount; i++)
+            {
+                ESM::CellRef ref;
+                ref.blank();
+
+                if (i < sRefCount - sPlacedCount)
+                {
+                    ref.mRefNum.mIndex = i + 1;
+                    ref.mRefNum.mContentFile = 0;
+                }
+                else
+                    ref.mMpNum = i + 1;
+
+                ref.mRefID = "object_id_" + std::to_string(i % 200);
+                mRefs.push_back(ref);
+            }
+
+            buildIndex();
+        }
+
+        void buildIndex()
+        {
+            mIndex.clear();
+            mIndex.reserve(mRefs.size());
+
+            for (std::size_t i = 0; i < mRefs.size(); i++)
+                mIndex.emplace(getKey(mRefs[i].mRefNum.mIndex, mRefs[i].mMpNum), i);
+        }
+
+        // Going through every reference in order, as searches by reference number and mpNum used to
+        const ESM::CellRef *searchByLinearScan(unsigned int refNum, unsigned int mpNum, const std::string &refId) const
+        {
+            for (const ESM::CellRef &ref : mRefs)
+            {
+                if (ref.mRefNum.mIndex == refNum && ref.mMpNum == mpNum &&
+                    (refId.empty() || Misc::StringUtils::ciEqual(ref.mRefID, refId)))
+                    return &ref;
+            }
+
+            return nullptr;
+        }
+
+        const ESM::CellRef *searchByIndex(unsigned int refNum, unsigned int mpNum, const std::string &refId) const
+        {
+            std::size_t foundPosition = mRefs.size();
+            auto range = mIndex.equal_range(getKey(refNum, mpNum));
+
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                const ESM::CellRef &ref = mRefs[it->second];
+
+                if (it->second < foundPosition && ref.mRefNum.mIndex == refNum && ref.mMpNum == mpNum &&
+                    (refId.empty() || Misc::StringUtils::ciEqual(ref.mRefID, refId)))
+                    foundPosition = it->second;
+            }
+
+            return foundPosition != mRefs.size() ? &mRefs[foundPosition] : nullptr;
+        }
+    };
+
+    struct Lookup
+    {
+        unsigned int mRefNum;
+        unsigned int mMpNum;
+        std::string mRefId;
+    };
+
+    // Objects packets refer to, spread over the whole cell
+    std::vector<Lookup> makeLookups(const Cell &cell, std::size_t count)
+    {
+        std::minstd_rand random(42);
+        std::vector<Lookup> lookups;
+        lookups.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const ESM::CellRef &ref = cell.mRefs[random() % cell.mRefs.size()];
+            lookups.push_back({ref.mRefNum.mIndex, ref.mMpNum, ref.mRefID});
+        }
+
+        return lookups;
+    }
+
+    void searchByLinearScan(benchmark::State& state)
+    {
+        Cell cell;
+        std::vector<Lookup> lookups = makeLookups(cell, 4096);
+        std::size_t step = 0;
+
+        while (state.KeepRunning())
+        {
+            const Lookup &lookup = lookups[step];
+            benchmark::DoNotOptimize(cell.searchByLinearScan(lookup.mRefNum, lookup.mMpNum, lookup.mRefId));
+            step = (step + 1) % lookups.size();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void searchByIndex(benchmark::State& state)
+    {
+        Cell cell;
+        std::vector<Lookup> lookups = makeLookups(cell, 4096);
+        std::size_t step = 0;
+
+        while (state.KeepRunning())
+        {
+            const Lookup &lookup = lookups[step];
+            benchmark::DoNotOptimize(cell.searchByIndex(lookup.mRefNum, lookup.mMpNum, lookup.mRefId));
+            step = (step + 1) % lookups.size();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Rebuilding the index for every lookup, as if every one of them followed a change to the cell
+    void searchByIndexAfterChange(benchmark::State& state)
+    {
+        Cell cell;
+        std::vector<Lookup> lookups = makeLookups(cell, 4096);
+        std::size_t step = 0;
+
+        while (state.KeepRunning())
+        {
+            const Lookup &lookup = lookups[step];
+            cell.buildIndex();
+            benchmark::DoNotOptimize(cell.searchByIndex(lookup.mRefNum, lookup.mMpNum, lookup.mRefId));
+            step = (step + 1) % lookups.size();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(searchByLinearScan);
+BENCHMARK(searchByIndex);
+BENCHMARK(searchByIndexAfterChange);
+
+BENCHMARK_MAIN();
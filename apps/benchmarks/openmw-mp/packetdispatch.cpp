@@ -0,0 +1,216 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Base/BasePlayer.hpp>
+#include <components/openmw-mp/Controllers/SystemPacketController.hpp>
+#include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+
+#include <RakPeerInterface.h>
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using namespace mwmp;
+
+    // How packet controllers and processors used to keep their packets, before they were indexed by
+    // packet ID, with the same packets in them
+    struct LegacyCategory
+    {
+        std::unordered_map<unsigned char, BasePacket*> mPackets;
+        // Stands in for the processors registered for this category, which were looked up the same way
+        std::unordered_map<unsigned char, bool> mProcessors;
+
+        bool containsPacket(RakNet::MessageID id) const
+        {
+            for (const auto &packet : mPackets)
+            {
+                if (packet.first == id)
+                    return true;
+            }
+            return false;
+        }
+
+        void setStream(RakNet::BitStream *inStream)
+        {
+            for (const auto &packet : mPackets)
+                packet.second->SetStreams(inStream, nullptr);
+        }
+
+        BasePacket *getPacket(RakNet::MessageID id)
+        {
+            return mPackets[id];
+        }
+
+        bool hasProcessor(RakNet::MessageID id) const
+        {
+            for (const auto &processor : mProcessors)
+            {
+                if (processor.first == id)
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    struct Controllers
+    {
+        RakNet::RakPeerInterface *mPeer;
+        SystemPacketController mSystem;
+        PlayerPacketController mPlayer;
+        ActorPacketController mActor;
+        ObjectPacketController mObject;
+        WorldstatePacketController mWorldstate;
+
+        // Mirrors the tables the server's Networking and its processors build from these controllers
+        std::array<BasePacket*, 256> mDispatchTable;
+        std::array<bool, 256> mProcessorTable;
+
+        // System, player, actor, object and worldstate packets, in the order Networking::update used to
+        // ask for them
+        std::array<LegacyCategory, 5> mLegacyCategories;
+
+        Controllers()
+            : mPeer(RakNet::RakPeerInterface::GetInstance())
+            , mSystem(mPeer), mPlayer(mPeer), mActor(mPeer), mObject(mPeer), mWorldstate(mPeer)
+        {
+            for (unsigned int id = 0; id < 256; id++)
+            {
+                RakNet::MessageID packetID = (RakNet::MessageID) id;
+                BasePacket *packet = nullptr;
+                int category = -1;
+
+                if (mSystem.ContainsPacket(packetID))
+                {
+                    packet = mSystem.GetPacket(packetID);
+                    category = 0;
+                }
+                else if (mPlayer.ContainsPacket(packetID))
+                {
+                    packet = mPlayer.GetPacket(packetID);
+                    category = 1;
+                }
+                else if (mActor.ContainsPacket(packetID))
+                {
+                    packet = mActor.GetPacket(packetID);
+                    category = 2;
+                }
+                else if (mObject.ContainsPacket(packetID))
+                {
+                    packet = mObject.GetPacket(packetID);
+                    category = 3;
+                }
+                else if (mWorldstate.ContainsPacket(packetID))
+                {
+                    packet = mWorldstate.GetPacket(packetID);
+                    category = 4;
+                }
+
+                mDispatchTable[id] = packet;
+                mProcessorTable[id] = packet != nullptr;
+
+                if (category >= 0)
+                {
+                    mLegacyCategories[category].mPackets[packetID] = packet;
+                    mLegacyCategories[category].mProcessors[packetID] = true;
+                }
+            }
+        }
+
+        ~Controllers()
+        {
+            RakNet::RakPeerInterface::DestroyInstance(mPeer);
+        }
+
+        // What Networking::update and Process() used to do to find the packet and its processor
+        BasePacket *getPacketByLegacyChain(RakNet::MessageID id, RakNet::BitStream *bsIn)
+        {
+            for (LegacyCategory &category : mLegacyCategories)
+            {
+                if (category.containsPacket(id))
+                {
+                    category.setStream(bsIn);
+
+                    if (!category.hasProcessor(id))
+                        return nullptr;
+
+                    return category.getPacket(id);
+                }
+            }
+            return nullptr;
+        }
+
+        // What they do now
+        BasePacket *getPacketByTable(RakNet::MessageID id, RakNet::BitStream *bsIn)
+        {
+            BasePacket *packet = mDispatchTable[id];
+
+            if (packet == nullptr)
+                return nullptr;
+
+            packet->SetReadStream(bsIn);
+            return mProcessorTable[id] ? packet : nullptr;
+        }
+    };
+
+    // A player position update, which is by far the most common packet a server receives
+    std::vector<unsigned char> makePositionPacket(Controllers &controllers, BasePlayer &player)
+    {
+        RakNet::BitStream bsOut;
+        PlayerPacket *packet = controllers.mPlayer.GetPacket(ID_PLAYER_POSITION);
+        packet->SetSendStream(&bsOut);
+        packet->setPlayer(&player);
+        packet->Packet(&bsOut, true);
+        return std::vector<unsigned char>(bsOut.GetData(), bsOut.GetData() + bsOut.GetNumberOfBytesUsed());
+    }
+
+    void dispatchByLegacyChain(benchmark::State& state)
+    {
+        Controllers controllers;
+        BasePlayer player(RakNet::RakNetGUID(1));
+        std::vector<unsigned char> data = makePositionPacket(controllers, player);
+
+        while (state.KeepRunning())
+        {
+            RakNet::BitStream bsIn(&data[1], (unsigned int) data.size() - 1, false);
+            bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size());
+
+            PlayerPacket *packet = static_cast<PlayerPacket*>(controllers.getPacketByLegacyChain(data[0], &bsIn));
+            packet->setPlayer(&player);
+            packet->Read();
+            benchmark::DoNotOptimize(player.position);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void dispatchByTable(benchmark::State& state)
+    {
+        Controllers controllers;
+        BasePlayer player(RakNet::RakNetGUID(1));
+        std::vector<unsigned char> data = makePositionPacket(controllers, player);
+
+        while (state.KeepRunning())
+        {
+            RakNet::BitStream bsIn(&data[1], (unsigned int) data.size() - 1, false);
+            bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size());
+
+            PlayerPacket *packet = static_cast<PlayerPacket*>(controllers.getPacketByTable(data[0], &bsIn));
+            packet->setPlayer(&player);
+            packet->Read();
+            benchmark::DoNotOptimize(player.position);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(dispatchByLegacyChain);
+BENCHMARK(dispatchByTable);
+
+BENCHMARK_MAIN();
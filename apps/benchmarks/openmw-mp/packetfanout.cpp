@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Packets/Actor/PacketActorPosition.hpp>
+
+#include <RakPeerInterface.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace mwmp;
+
+    // The peer is never started, so RakNet discards the data right away and only the cost of
+    // building the packet for each recipient gets measured
+    struct Fixture
+    {
+        RakNet::RakPeerInterface *mPeer;
+        RakNet::BitStream mBsOut;
+        BaseActorList mActorList;
+        std::vector<RakNet::RakNetGUID> mRecipients;
+
+        Fixture(unsigned int actorCount, unsigned int recipientCount)
+            : mPeer(RakNet::RakPeerInterface::GetInstance())
+        {
+            mActorList.cell.blank();
+            mActorList.guid = RakNet::RakNetGUID(1);
+
+            for (unsigned int i = 0; i < actorCount; i++)
+            {
+                BaseActor actor;
+                actor.refNum = i;
+                actor.mpNum = 0;
+                actor.position.pos[0] = static_cast<float>(i);
+                actor.position.pos[1] = static_cast<float>(i * 2);
+                actor.position.pos[2] = static_cast<float>(i * 3);
+                mActorList.baseActors.push_back(actor);
+            }
+
+            mActorList.count = actorCount;
+
+            for (unsigned int i = 0; i < recipientCount; i++)
+                mRecipients.emplace_back(i + 2);
+        }
+
+        ~Fixture()
+        {
+            RakNet::RakPeerInterface::DestroyInstance(mPeer);
+        }
+    };
+
+    void sendPerRecipient(benchmark::State& state)
+    {
+        Fixture fixture(static_cast<unsigned int>(state.range(0)), static_cast<unsigned int>(state.range(1)));
+        PacketActorPosition packet(fixture.mPeer);
+        packet.SetSendStream(&fixture.mBsOut);
+
+        while (state.KeepRunning())
+        {
+            for (const auto &guid : fixture.mRecipients)
+            {
+                packet.setActorList(&fixture.mActorList);
+                packet.Send(guid);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void sendSerializedOnce(benchmark::State& state)
+    {
+        Fixture fixture(static_cast<unsigned int>(state.range(0)), static_cast<unsigned int>(state.range(1)));
+        PacketActorPosition packet(fixture.mPeer);
+        packet.SetSendStream(&fixture.mBsOut);
+
+        while (state.KeepRunning())
+        {
+            packet.setActorList(&fixture.mActorList);
+            packet.Send(fixture.mRecipients);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+// Arguments are the number of actors in the packet and the number of players with the cell loaded
+BENCHMARK(sendPerRecipient)->Args({1, 40})->Args({20, 40})->Args({100, 40})->Args({20, 100});
+BENCHMARK(sendSerializedOnce)->Args({1, 40})->Args({20, 40})->Args({100, 40})->Args({20, 100});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/Packets/Worldstate/PacketWorldMap.hpp>
+
+#include <BitStream.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace mwmp;
+
+    // Every exterior of Vvardenfell explored, with each tile as large as the server accepts
+    constexpr int sTileCount = 1200;
+
+    struct Fixture
+    {
+        BaseWorldstate mWorldstate;
+        int64_t mImageBytes = 0;
+
+        Fixture()
+        {
+            for (int i = 0; i < sTileCount; i++)
+            {
+                MapTile mapTile;
+                mapTile.x = i % 40 - 20;
+                mapTile.y = i / 40 - 15;
+                mapTile.imageData.resize(maxImageDataSize);
+
+                for (int j = 0; j < maxImageDataSize; j++)
+                    mapTile.imageData[j] = static_cast<char>(i * 31 + j * 7);
+
+                mImageBytes += mapTile.imageData.size();
+                mWorldstate.mapTiles.push_back(mapTile);
+            }
+        }
+    };
+
+    // How PacketWorldMap used to write the image of every tile
+    void writeImagesOneByteAtATime(benchmark::State& state)
+    {
+        Fixture fixture;
+        RakNet::BitStream bs;
+
+        while (state.KeepRunning())
+        {
+            bs.ResetWritePointer();
+
+            for (const auto &mapTile : fixture.mWorldstate.mapTiles)
+            {
+                for (char imageChar : mapTile.imageData)
+                    bs.Write(imageChar);
+            }
+
+            benchmark::DoNotOptimize(bs.GetData());
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.mImageBytes);
+    }
+
+    void writeImagesInBulk(benchmark::State& state)
+    {
+        Fixture fixture;
+        RakNet::BitStream bs;
+
+        while (state.KeepRunning())
+        {
+            bs.ResetWritePointer();
+
+            for (const auto &mapTile : fixture.mWorldstate.mapTiles)
+                bs.Write(mapTile.imageData.data(), static_cast<unsigned int>(mapTile.imageData.size()));
+
+            benchmark::DoNotOptimize(bs.GetData());
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.mImageBytes);
+    }
+
+    void serializeWorldMap(benchmark::State& state)
+    {
+        Fixture fixture;
+        RakNet::BitStream bs;
+        PacketWorldMap packet(nullptr);
+        packet.SetSendStream(&bs);
+        packet.setWorldstate(&fixture.mWorldstate);
+
+        while (state.KeepRunning())
+            benchmark::DoNotOptimize(packet.Serialize());
+
+        state.SetBytesProcessed(state.iterations() * fixture.mImageBytes);
+    }
+
+    void readWorldMap(benchmark::State& state)
+    {
+        Fixture fixture;
+        RakNet::BitStream bs;
+        PacketWorldMap sender(nullptr);
+        sender.SetSendStream(&bs);
+        sender.setWorldstate(&fixture.mWorldstate);
+        BasePacket::SerializedPacket data = sender.Serialize();
+
+        BaseWorldstate receivedWorldstate;
+        PacketWorldMap receiver(nullptr);
+        receiver.setWorldstate(&receivedWorldstate);
+
+        while (state.KeepRunning())
+        {
+            RakNet::BitStream readStream(const_cast<unsigned char *>(data->data()),
+                static_cast<unsigned int>(data->size()), false);
+            readStream.IgnoreBytes(BasePacket::headerSize());
+
+            receiver.SetReadStream(&readStream);
+            receiver.Read();
+            benchmark::DoNotOptimize(receivedWorldstate.mapTiles.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.mImageBytes);
+    }
+} // namespace
+
+BENCHMARK(writeImagesOneByteAtATime);
+BENCHMARK(writeImagesInBulk);
+BENCHMARK(serializeWorldMap);
+BENCHMARK(readWorldMap);
+
+BENCHMARK_MAIN();
@@ -71,7 +71,8 @@ void QueryHelper::update(const QString &addr, unsigned short port, const QueryDa
 void QueryUpdate::process()
 {
     auto data = QueryClient::Get().Query();
-    if (QueryClient::Get().Status() != ID_MASTER_QUERY)
+    int status = QueryClient::Get().Status();
+    if (status != ID_MASTER_QUERY && status != ID_MASTER_QUERY_DELTA)
     {
         emit finished();
         return;
@@ -78,11 +78,8 @@ void ServerInfoDialog::refresh()
             listPlugins->addItem(QString::fromStdString(plugin.name));
 
         listRules->clear();
-        const static vector<std::string> defaultRules {"gamemode", "maxPlayers", "name", "passw", "players", "version"};
         for (auto &rule : sd.second.rules)
         {
-            if (::find(defaultRules.begin(), defaultRules.end(), rule.first) != defaultRules.end())
-                continue;
             QString ruleStr = QString::fromStdString(rule.first) + " : ";
             if (rule.second.type == 's')
                 ruleStr += QString::fromStdString(rule.second.str);
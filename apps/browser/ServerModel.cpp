@@ -29,28 +29,28 @@ QVariant ServerModel::data(const QModelIndex &index, int role) const
                 var = sd.addr;
                 break;
             case ServerData::PASSW:
-                var = (int)(sd.rules.at("passw").val) == 1 ? "Yes" : "No";
+                var = sd.GetPassword() == 1 ? "Yes" : "No";
                 break;
             case ServerData::VERSION:
-                var = QString(sd.rules.at("version").str.c_str());
+                var = QString(sd.GetVersion());
                 break;
             case ServerData::PLAYERS:
-                var = (int) sd.rules.at("players").val;
+                var = sd.GetPlayers();
                 break;
             case ServerData::MAX_PLAYERS:
-                var = (int) sd.rules.at("maxPlayers").val;
+                var = sd.GetMaxPlayers();
                 break;
             case ServerData::HOSTNAME:
-                var = QString(sd.rules.at("name").str.c_str());
+                var = QString(sd.GetName());
                 break;
             case ServerData::PING:
                 var = sd.ping == PING_UNREACHABLE ? QVariant("Unreachable") : sd.ping;
                 break;
             case ServerData::MODNAME:
-                if (sd.rules.at("gamemode").str == "")
+                if (sd.gameMode.empty())
                     var = "default";
                 else
-                    var = QString(sd.rules.at("gamemode").str.c_str());
+                    var = QString(sd.GetGameMode());
                 break;
         }
         return var;
@@ -14,21 +14,31 @@ QueryClient::QueryClient()
     peer = RakPeerInterface::GetInstance();
     pmq = new PacketMasterQuery(peer);
     pmu = new PacketMasterUpdate(peer);
+    pmqd = new PacketMasterQueryDelta(peer);
     RakNet::SocketDescriptor sd;
     peer->Startup(8, &sd, 1);
     status = -1;
+    instance = 0;
+    revision = 0;
+    isDeltaSupported = true;
 }
 
 QueryClient::~QueryClient()
 {
     delete pmq;
     delete pmu;
+    delete pmqd;
     RakPeerInterface::DestroyInstance(peer);
 }
 
 void QueryClient::SetServer(const string &addr, unsigned short port)
 {
     masterAddr = SystemAddress(addr.c_str(), port);
+
+    cachedServers.clear();
+    instance = 0;
+    revision = 0;
+    isDeltaSupported = true;
 }
 
 QueryClient &QueryClient::Get()
@@ -38,31 +48,119 @@ QueryClient &QueryClient::Get()
 }
 
 map<SystemAddress, QueryData> QueryClient::Query()
+{
+    qDebug() << "Locking mutex in QueryClient::Query()";
+    mxServers.lock();
+    status = -1;
+
+    map<SystemAddress, QueryData> query;
+
+    if (isDeltaSupported && QueryChanges())
+        query = cachedServers;
+    else
+        query = QueryAll();
+
+    peer->CloseConnection(masterAddr, true);
+    qDebug() << "Unlocking mutex in QueryClient::Query()";
+    mxServers.unlock();
+    qDebug() <<"Answer" << (status == ID_MASTER_QUERY || status == ID_MASTER_QUERY_DELTA ? "ok." : "wrong.");
+
+    return query;
+}
+
+bool QueryClient::QueryChanges()
+{
+    QueryDeltaRequest request;
+    request.instance = instance;
+    request.revision = revision;
+
+    QueryDeltaResponse response;
+    bool isFirstPage = true;
+    uint32_t newInstance = 0;
+    uint64_t newRevision = 0;
+
+    do
+    {
+        if (Connect() == IS_NOT_CONNECTED)
+            return false;
+
+        BitStream bs;
+        pmqd->SetSendStream(&bs);
+        pmqd->SetRequest(&request);
+        pmqd->Send(masterAddr);
+
+        pmqd->SetResponse(&response);
+        status = GetAnswer(ID_MASTER_QUERY_DELTA);
+
+        if (status != ID_MASTER_QUERY_DELTA || !pmqd->isPacketValid())
+        {
+            // Masters from before delta queries close the connection or answer with another packet, while a lost
+            // connection says nothing about what the master supports, so delta queries are tried again next time
+            if (isFirstPage && status != -1 && status != ID_MASTER_QUERY_DELTA)
+            {
+                qDebug() << "Master server does not support delta queries";
+                isDeltaSupported = false;
+            }
+
+            // Some changes may have been applied already, so start over next time
+            cachedServers.clear();
+            instance = 0;
+            revision = 0;
+            return false;
+        }
+
+        if (isFirstPage)
+        {
+            // Ask for the later pages the same way, as if the client knew nothing
+            if (response.isComplete)
+            {
+                cachedServers.clear();
+                request.revision = 0;
+            }
+
+            // Anything that changes while the later pages are read has a newer revision than the first page,
+            // so it gets sent again by the next query
+            newInstance = response.instance;
+            newRevision = response.revision;
+            isFirstPage = false;
+        }
+
+        for (const auto &addr : response.removed)
+            cachedServers.erase(addr);
+
+        for (auto &server : response.servers)
+            cachedServers[server.first] = move(server.second);
+
+        request.hasCursor = response.hasMore;
+        request.cursor = response.cursor;
+    }
+    while (response.hasMore);
+
+    qDebug() << "Got the changes, now knowing" << cachedServers.size() << "servers";
+
+    instance = newInstance;
+    revision = newRevision;
+    return true;
+}
+
+map<SystemAddress, QueryData> QueryClient::QueryAll()
 {
     map<SystemAddress, QueryData> query;
     BitStream bs;
     bs.Write((unsigned char) (ID_MASTER_QUERY));
-    qDebug() << "Locking mutex in QueryClient::Query()";
-    mxServers.lock();
+    // Ask for the compact encoding, which older masters ignore
+    bs.Write(true);
     status = -1;
     int attempts = 3;
     do
     {
         if (Connect() == IS_NOT_CONNECTED)
-        {
-            qDebug() << "Unlocking mutex in QueryClient::Query()";
-            mxServers.unlock();
             return query;
-        }
 
         int code = peer->Send(&bs, HIGH_PRIORITY, RELIABLE_ORDERED, CHANNEL_MASTER, masterAddr, false);
 
         if (code == 0)
-        {
-            qDebug() << "Unlocking mutex in QueryClient::Query()";
-            mxServers.unlock();
             return query;
-        }
 
         pmq->SetServers(&query);
         status = GetAnswer(ID_MASTER_QUERY);
@@ -71,10 +169,6 @@ map<SystemAddress, QueryData> QueryClient::Query()
     while(status != ID_MASTER_QUERY && attempts-- > 0);
     if(status != ID_MASTER_QUERY)
         qDebug() << "Getting query was failed";
-    qDebug() << "Unlocking mutex in QueryClient::Query()";
-    peer->CloseConnection(masterAddr, true);
-    mxServers.unlock();
-    qDebug() <<"Answer" << (status == ID_MASTER_QUERY ? "ok." : "wrong.");
 
     return query;
 }
@@ -86,6 +180,7 @@ pair<SystemAddress, QueryData> QueryClient::Update(const RakNet::SystemAddress &
     BitStream bs;
     bs.Write((unsigned char) (ID_MASTER_UPDATE));
     bs.Write(addr);
+    bs.Write(true);
 
     mxServers.lock();
     status = -1;
@@ -127,14 +222,19 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
             BitStream data(packet->data, packet->length, false);
             pmq->SetReadStream(&data);
             pmu->SetReadStream(&data);
+            pmqd->SetReadStream(&data);
             data.Read(pid);
             switch(pid)
             {
                 case ID_CONNECTION_LOST:
                     qDebug() << "ID_CONNECTION_LOST";
+                    update = false;
+                    break;
                 case ID_DISCONNECTION_NOTIFICATION:
+                    // Unlike a lost connection, this is the master closing it on purpose
                     qDebug() << "Disconnected";
                     update = false;
+                    id = pid;
                     break;
                 case ID_MASTER_QUERY:
                     qDebug() << "ID_MASTER_QUERY";
@@ -154,6 +254,15 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
                     update = false;
                     id = pid;
                     break;
+                case ID_MASTER_QUERY_DELTA:
+                    qDebug() << "ID_MASTER_QUERY_DELTA";
+                    if (waitingPacket == ID_MASTER_QUERY_DELTA)
+                        pmqd->Read();
+                    else
+                        qDebug() << "Got wrong packet";
+                    update = false;
+                    id = pid;
+                    break;
                 case ID_MASTER_ANNOUNCE:
                     qDebug() << "ID_MASTER_ANNOUNCE";
                     update = false;
@@ -166,7 +275,10 @@ MASTER_PACKETS QueryClient::GetAnswer(MASTER_PACKETS waitingPacket)
                     break;
             }
         }
-        RakSleep(500);
+
+        // Every page of a delta query waits for its own answer, so poll often and stop as soon as one arrives
+        if (update)
+            RakSleep(10);
     }
     return (MASTER_PACKETS)(id);
 }
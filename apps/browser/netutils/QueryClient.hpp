@@ -5,6 +5,7 @@
 #include <RakPeerInterface.h>
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
+#include <components/openmw-mp/Master/PacketMasterQueryDelta.hpp>
 #include <apps/browser/ServerModel.hpp>
 #include <mutex>
 
@@ -23,6 +24,9 @@ public:
     int Status();
 private:
     RakNet::ConnectionState Connect();
+    // Bring cachedServers up to date with the changes since the last query, returning false if that failed
+    bool QueryChanges();
+    std::map<RakNet::SystemAddress, QueryData> QueryAll();
     MASTER_PACKETS GetAnswer(MASTER_PACKETS packet);
 protected:
     QueryClient();
@@ -33,6 +37,13 @@ private:
     RakNet::SystemAddress masterAddr;
     mwmp::PacketMasterQuery *pmq;
     mwmp::PacketMasterUpdate *pmu;
+    mwmp::PacketMasterQueryDelta *pmqd;
+    // The servers as of the master's list revision, so only what changed since then needs to be sent again
+    std::map<RakNet::SystemAddress, QueryData> cachedServers;
+    uint32_t instance;
+    uint64_t revision;
+    // Cleared once a master turns out to only know full queries
+    bool isDeltaSupported;
     std::pair<RakNet::SystemAddress, ServerData> server;
     std::mutex mxServers;
 
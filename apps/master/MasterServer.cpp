@@ -7,6 +7,7 @@
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
 #include <components/openmw-mp/Master/PacketMasterAnnounce.hpp>
+#include <components/openmw-mp/Master/PacketMasterQueryDelta.hpp>
 #include <components/openmw-mp/Version.hpp>
 
 using namespace RakNet;
@@ -14,7 +15,7 @@ using namespace std;
 using namespace mwmp;
 using namespace chrono;
 
-MasterServer::MasterServer(unsigned short maxConnections, unsigned short port)
+MasterServer::MasterServer(unsigned short maxConnections, unsigned short port) : servers(60s)
 {
     peer = RakPeerInterface::GetInstance();
     sockdescr = SocketDescriptor(port, 0);
@@ -32,12 +33,18 @@ MasterServer::~MasterServer()
 
 using namespace chrono;
 
+constexpr seconds MasterServer::updateInterval;
+
 void MasterServer::Thread()
 {
     unsigned char packetId = 0;
 
     auto startTime = chrono::steady_clock::now();
 
+    // Changes are only passed on every updateInterval, since each one can mean rebuilding the whole server list
+    bool serversChanged = false;
+    auto lastUpdateCallback = startTime;
+
     BitStream send;
     PacketMasterQuery pmq(peer);
     pmq.SetSendStream(&send);
@@ -48,21 +55,21 @@ void MasterServer::Thread()
     PacketMasterAnnounce pma(peer);
     pma.SetSendStream(&send);
 
+    PacketMasterQueryDelta pmqd(peer);
+    pmqd.SetSendStream(&send);
+
     while (run)
     {
         Packet *packet = peer->Receive();
 
         auto now = steady_clock::now();
+
+        if (servers.Expire(now) != 0)
+            serversChanged = true;
+
         if (now - startTime >= 60s)
         {
             startTime = steady_clock::now();
-            for (auto it = servers.begin(); it != servers.end();)
-            {
-
-                if (it->second.lastUpdate + 60s <= now)
-                    servers.erase(it++);
-                else ++it;
-            }
             for(auto id = pendingACKs.begin(); id != pendingACKs.end();)
             {
                 if(now - id->second >= 30s)
@@ -96,24 +103,59 @@ void MasterServer::Thread()
                         break;
                     case ID_MASTER_QUERY:
                     {
-                        pmq.SetServers(reinterpret_cast<map<SystemAddress, QueryData> *>(&servers));
+                        // Clients from before the compact encoding send nothing after the packet ID
+                        bool compact = false;
+                        data.Read(compact);
+
+                        auto snapshot = servers.GetSnapshot();
+                        // Only read while sending
+                        pmq.SetServers(const_cast<ServerRegistry::QueryMap *>(snapshot.get()));
+                        pmq.SetCompact(compact);
                         pmq.Send(packet->systemAddress);
                         pendingACKs[packet->guid] = steady_clock::now();
 
-                        cout << "Sent info about all " << servers.size() << " servers to "
+                        cout << "Sent info about all " << snapshot->size() << " servers to "
                              << packet->systemAddress.ToString() << endl;
                         break;
                     }
+                    case ID_MASTER_QUERY_DELTA:
+                    {
+                        QueryDeltaRequest request;
+                        pmqd.SetReadStream(&data);
+                        pmqd.SetRequest(&request);
+                        pmqd.Read();
+
+                        if (!pmqd.isPacketValid())
+                        {
+                            peer->CloseConnection(packet->systemAddress, true);
+                            break;
+                        }
+
+                        QueryDeltaResponse response;
+                        servers.GetChanges(request, response);
+
+                        pmqd.SetResponse(&response);
+                        pmqd.Send(packet->systemAddress);
+                        pendingACKs[packet->guid] = steady_clock::now();
+
+                        cout << "Sent " << response.servers.size() << " changed and " << response.removed.size()
+                             << " removed servers to " << packet->systemAddress.ToString() << endl;
+                        break;
+                    }
                     case ID_MASTER_UPDATE:
                     {
                         SystemAddress addr;
                         data.Read(addr); // update 1 server
 
-                        ServerIter it = servers.find(addr);
-                        if (it != servers.end())
+                        bool compact = false;
+                        data.Read(compact);
+
+                        SServer server;
+                        if (servers.Find(addr, server))
                         {
-                            pair<SystemAddress, QueryData> pairPtr(it->first, static_cast<QueryData>(it->second));
+                            pair<SystemAddress, QueryData> pairPtr(addr, static_cast<QueryData>(server));
                             pmu.SetServer(&pairPtr);
+                            pmu.SetCompact(compact);
                             pmu.Send(packet->systemAddress);
                             pendingACKs[packet->guid] = steady_clock::now();
                             cout << "Sent info about " << addr.ToString() << " to " << packet->systemAddress.ToString()
@@ -123,7 +165,7 @@ void MasterServer::Thread()
                     }
                     case ID_MASTER_ANNOUNCE:
                     {
-                        ServerIter iter = servers.find(packet->systemAddress);
+                        bool isKnown = servers.Contains(packet->systemAddress);
 
                         pma.SetReadStream(&data);
                         SServer server;
@@ -131,37 +173,45 @@ void MasterServer::Thread()
                         pma.Read();
 
                         auto keepAliveFunc = [&]() {
-                            iter->second.lastUpdate = now;
-                            pma.SetFunc(PacketMasterAnnounce::FUNCTION_KEEP);
+                            // Let the server know its compact announcement was understood
+                            pma.SetFunc(pma.GetFunc() == PacketMasterAnnounce::FUNCTION_ANNOUNCE_COMPACT ?
+                                PacketMasterAnnounce::FUNCTION_KEEP_COMPACT : PacketMasterAnnounce::FUNCTION_KEEP);
                             pma.Send(packet->systemAddress);
                             pendingACKs[packet->guid] = steady_clock::now();
                         };
 
-                        if (iter != servers.end())
+                        if (isKnown)
                         {
                             if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_DELETE)
                             {
-                                servers.erase(iter);
+                                servers.Erase(packet->systemAddress);
+                                serversChanged = true;
                                 cout << "Deleted";
                                 pma.Send(packet->systemAddress);
                                 pendingACKs[packet->guid] = steady_clock::now();
                             }
-                            else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_ANNOUNCE)
+                            else if (pma.IsAnnounce())
                             {
                                 cout << "Updated";
-                                iter->second = server;
+                                server.lastUpdate = now;
+                                servers.Set(packet->systemAddress, server);
+                                serversChanged = true;
                                 keepAliveFunc();
                             }
                             else
                             {
                                 cout << "Keeping alive";
+                                servers.Touch(packet->systemAddress, now);
+                                serversChanged = true;
                                 keepAliveFunc();
                             }
                         }
-                        else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_ANNOUNCE)
+                        else if (pma.IsAnnounce())
                         {
                             cout << "Added";
-                            iter = servers.insert({packet->systemAddress, server}).first;
+                            server.lastUpdate = now;
+                            servers.Set(packet->systemAddress, server);
+                            serversChanged = true;
                             keepAliveFunc();
                         }
                         else
@@ -186,6 +236,13 @@ void MasterServer::Thread()
                         peer->CloseConnection(packet->systemAddress, true);
                 }
             }
+
+        if (serversChanged && updateCallback && steady_clock::now() - lastUpdateCallback >= updateInterval)
+        {
+            updateCallback();
+            serversChanged = false;
+            lastUpdateCallback = steady_clock::now();
+        }
     }
     peer->Shutdown(1000);
     RakPeerInterface::DestroyInstance(peer);
@@ -226,7 +283,12 @@ void MasterServer::Wait()
     }
 }
 
-MasterServer::ServerMap *MasterServer::GetServers()
+ServerRegistry *MasterServer::GetServers()
 {
     return &servers;
 }
+
+void MasterServer::SetUpdateCallback(std::function<void()> callback)
+{
+    updateCallback = std::move(callback);
+}
@@ -3,8 +3,10 @@
 
 #include <thread>
 #include <chrono>
+#include <functional>
 #include <RakPeerInterface.h>
 #include <components/openmw-mp/Master/MasterData.hpp>
+#include "ServerRegistry.hpp"
 
 class MasterServer
 {
@@ -17,13 +19,7 @@ public:
         {
         } date;
     };
-    struct SServer : QueryData
-    {
-        std::chrono::steady_clock::time_point lastUpdate;
-    };
-    typedef std::map<RakNet::SystemAddress, SServer> ServerMap;
-    //typedef ServerMap::const_iterator ServerCIter;
-    typedef ServerMap::iterator ServerIter;
+    typedef ServerRegistry::Server SServer;
 
     MasterServer(unsigned short maxConnections, unsigned short port);
     ~MasterServer();
@@ -33,7 +29,10 @@ public:
     bool isRunning();
     void Wait();
 
-    ServerMap* GetServers();
+    ServerRegistry* GetServers();
+
+    // Called on the master thread once the servers have changed, at most once per updateInterval
+    void SetUpdateCallback(std::function<void()> callback);
 
 private:
     void Thread();
@@ -42,8 +41,10 @@ private:
     std::thread tMasterThread;
     RakNet::RakPeerInterface* peer;
     RakNet::SocketDescriptor sockdescr;
-    ServerMap servers;
+    ServerRegistry servers;
     bool run;
+    std::function<void()> updateCallback;
+    static constexpr std::chrono::seconds updateInterval{1};
     std::map<RakNet::RakNetGUID, std::chrono::steady_clock::time_point> pendingACKs;
 };
 
@@ -2,6 +2,9 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 
 using namespace std;
 using namespace chrono;
@@ -30,23 +33,108 @@ inline void ptreeToServer(boost::property_tree::ptree &pt, MasterServer::SServer
     server.SetMaxPlayers(pt.get<unsigned>("max_players"));
 }
 
-inline void queryToStringStream(stringstream &ss, string addr, MasterServer::SServer &query)
+// Append a string as a JSON string literal, escaping whatever would end it early
+inline void appendJsonString(string &out, const char *str)
 {
-    ss <<"\"" << addr << "\":{";
-    ss << "\"modname\": \"" << query.GetGameMode() << "\"" << ", ";
-    ss << "\"passw\": " << (query.GetPassword() ? "true" : "false") << ", ";
-    ss << "\"hostname\": \"" << query.GetName() << "\"" << ", ";
-    ss << "\"query_port\": " << 0 << ", ";
-    ss << "\"last_update\": " << duration_cast<seconds>(steady_clock::now() - query.lastUpdate).count() << ", ";
-    ss << "\"players\": " << query.GetPlayers() << ", ";
-    ss << "\"version\": \"" << query.GetVersion() << "\"" << ", ";
-    ss << "\"max_players\": " << query.GetMaxPlayers();
-    ss << "}";
+    out += '"';
+
+    for (; *str != '\0'; str++)
+    {
+        unsigned char c = (unsigned char) *str;
+
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += (char) c;
+        }
+        else if (c < 0x20)
+        {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        }
+        else
+            out += (char) c;
+    }
+
+    out += '"';
+}
+
+inline void appendServer(string &out, const string &addr, const MasterServer::SServer &query, steady_clock::time_point now)
+{
+    out += '"';
+    out += addr;
+    out += "\":{\"modname\": ";
+    appendJsonString(out, query.GetGameMode());
+    out += ", \"passw\": ";
+    out += query.GetPassword() ? "true" : "false";
+    out += ", \"hostname\": ";
+    appendJsonString(out, query.GetName());
+    out += ", \"query_port\": 0, \"last_update\": ";
+    out += to_string(duration_cast<seconds>(now - query.lastUpdate).count());
+    out += ", \"players\": ";
+    out += to_string(query.GetPlayers());
+    out += ", \"version\": ";
+    appendJsonString(out, query.GetVersion());
+    out += ", \"max_players\": ";
+    out += to_string(query.GetMaxPlayers());
+    out += '}';
+}
+
+inline string makeResponse(const string &content, const char *type, const char *encoding = nullptr,
+    const char *vary = nullptr)
+{
+    string response = "HTTP/1.1 200 OK\r\nContent-Type: ";
+    response += type;
+    response += "\r\n";
+
+    if (encoding != nullptr)
+    {
+        response += "Content-Encoding: ";
+        response += encoding;
+        response += "\r\n";
+    }
+
+    if (vary != nullptr)
+    {
+        response += "Vary: ";
+        response += vary;
+        response += "\r\n";
+    }
+
+    response += "Content-Length: " + to_string(content.length()) + "\r\n\r\n";
+    response += content;
+    return response;
+}
+
+inline string gzip(const string &content)
+{
+    string compressed;
+    boost::iostreams::filtering_ostream stream;
+    stream.push(boost::iostreams::gzip_compressor());
+    stream.push(boost::iostreams::back_inserter(compressed));
+    stream.write(content.data(), content.size());
+    boost::iostreams::close(stream);
+    return compressed;
 }
 
-RestServer::RestServer(unsigned short port, MasterServer::ServerMap *pMap) : serverMap(pMap)
+inline bool acceptsGzip(const HttpServer::Request &request)
+{
+    auto range = request.header.equal_range("Accept-Encoding");
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.find("gzip") != string::npos)
+            return true;
+    }
+
+    return false;
+}
+
+RestServer::RestServer(unsigned short port, ServerRegistry *servers) : servers(servers)
 {
     httpServer.config.port = port;
+    cacheUpdated();
 }
 
 void RestServer::start()
@@ -60,13 +148,17 @@ void RestServer::start()
         {
             try
             {
-                stringstream ss;
-                ss << "{";
                 auto addr = request->path_match[1].str();
                 auto port = (unsigned short)stoi(&(addr[addr.find(':')+1]));
-                queryToStringStream(ss, "server", serverMap->at(RakNet::SystemAddress(addr.c_str(), port)));
-                ss << "}";
-                ResponseStr(*response, ss.str(), "application/json");
+
+                MasterServer::SServer server;
+                if (!servers->Find(RakNet::SystemAddress(addr.c_str(), port), server))
+                    throw out_of_range(addr);
+
+                string content = "{";
+                appendServer(content, "server", server, steady_clock::now());
+                content += "}";
+                ResponseStr(*response, content, "application/json");
             }
             catch(out_of_range e)
             {
@@ -75,24 +167,8 @@ void RestServer::start()
         }
         else
         {
-            static string str;
-
-            //if (updatedCache)
-            {
-                stringstream ss;
-                ss << "{";
-                ss << "\"list servers\":{";
-                for (auto query = serverMap->begin(); query != serverMap->end(); query++)
-                {
-                    queryToStringStream(ss, query->first.ToString(true, ':'), query->second);
-                    if (next(query) != serverMap->end())
-                        ss << ", ";
-                }
-                ss << "}}";
-                ResponseStr(*response, ss.str(), "application/json");
-                updatedCache = false;
-            }
-            *response << str;
+            shared_ptr<const Cache> current = atomic_load(&cache);
+            *response << (acceptsGzip(*request) ? current->serversGzip : current->servers);
         }
     };
 
@@ -108,8 +184,8 @@ void RestServer::start()
 
             unsigned short port = pt.get<unsigned short>("port");
             server.lastUpdate = steady_clock::now();
-            serverMap->insert({RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port), server});
-            updatedCache = true;
+            servers->Set(RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port), server);
+            cacheUpdated();
 
             *response << response201;
         }
@@ -125,14 +201,8 @@ void RestServer::start()
         auto addr = request->path_match[1].str();
         auto port = (unsigned short)stoi(&(addr[addr.find(':')+1]));
 
-        auto query = serverMap->find(RakNet::SystemAddress(request->remote_endpoint_address.c_str(), port));
-
-        if (query == serverMap->end())
-        {
-            cout << request->remote_endpoint_address + ": Trying to update a non-existent server or without permissions." << endl;
-            *response << response400;
-            return;
-        }
+        RakNet::SystemAddress serverAddr(request->remote_endpoint_address.c_str(), port);
+        bool isKnown;
 
         if (request->content.size() != 0)
         {
@@ -141,33 +211,39 @@ void RestServer::start()
                 ptree pt;
                 read_json(request->content, pt);
 
-                ptreeToServer(pt, query->second);
-
-                updatedCache = true;
+                isKnown = servers->Modify(serverAddr, [&pt](MasterServer::SServer &server) {
+                    // Leave the server as it was if the update turns out to be incomplete
+                    MasterServer::SServer updatedServer = server;
+                    ptreeToServer(pt, updatedServer);
+                    updatedServer.lastUpdate = steady_clock::now();
+                    server = move(updatedServer);
+                });
             }
             catch(exception &e)
             {
                 cout << e.what() << endl;
                 *response << response400;
+                return;
             }
         }
+        else
+            isKnown = servers->Touch(serverAddr, steady_clock::now());
+
+        if (!isKnown)
+        {
+            cout << request->remote_endpoint_address + ": Trying to update a non-existent server or without permissions." << endl;
+            *response << response400;
+            return;
+        }
 
-        query->second.lastUpdate = steady_clock::now();
+        // Even a bare keepalive changes the server's last_update
+        cacheUpdated();
 
         *response << response202;
     };
 
     httpServer.resource["/api/servers/info"]["GET"] = [this](auto response, auto /*request*/) {
-        stringstream ss;
-        ss << '{';
-        ss << "\"servers\": " << serverMap->size();
-        unsigned int players = 0;
-        for (auto s : *serverMap)
-            players += s.second.GetPlayers();
-        ss << ", \"players\": " << players;
-        ss << "}";
-
-        ResponseStr(*response, ss.str(), "application/json");
+        *response << atomic_load(&cache)->info;
     };
 
     httpServer.default_resource["GET"]=[](auto response, auto /*request*/) {
@@ -179,7 +255,41 @@ void RestServer::start()
 
 void RestServer::cacheUpdated()
 {
-    updatedCache = true;
+    // Keep a slower rebuild from replacing the result of one that started after it
+    lock_guard<mutex> lock(cacheMutex);
+
+    auto now = steady_clock::now();
+    auto newCache = make_shared<Cache>();
+
+    string content;
+    // Roughly what a server takes, to avoid growing the string again and again
+    content.reserve(64 + servers->Size() * 192);
+    content += "{\"list servers\":{";
+
+    unsigned int serverCount = 0;
+    unsigned int players = 0;
+    // Not the version of ToString() returning a static buffer, as requests can rebuild this too
+    char addr[64];
+
+    servers->ForEach([&](const RakNet::SystemAddress &serverAddr, const MasterServer::SServer &server) {
+        if (serverCount != 0)
+            content += ", ";
+
+        serverAddr.ToString(true, addr, ':');
+        appendServer(content, addr, server, now);
+        serverCount++;
+        players += server.GetPlayers();
+    });
+
+    content += "}}";
+
+    // Both lists depend on Accept-Encoding, so caches in between have to keep them apart
+    newCache->servers = makeResponse(content, "application/json", nullptr, "Accept-Encoding");
+    newCache->serversGzip = makeResponse(gzip(content), "application/json", "gzip", "Accept-Encoding");
+    newCache->info = makeResponse("{\"servers\": " + to_string(serverCount) + ", \"players\": " +
+        to_string(players) + "}", "application/json");
+
+    atomic_store(&cache, shared_ptr<const Cache>(move(newCache)));
 }
 
 void RestServer::stop()
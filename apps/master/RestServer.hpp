@@ -1,6 +1,8 @@
 #ifndef NEWRESTAPI_RESTSERVER_HPP
 #define NEWRESTAPI_RESTSERVER_HPP
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include "MasterServer.hpp"
@@ -11,15 +13,27 @@ typedef SimpleWeb::Server<SimpleWeb::HTTP> HttpServer;
 class RestServer
 {
 public:
-    RestServer(unsigned short port, MasterServer::ServerMap *pMap);
+    RestServer(unsigned short port, ServerRegistry *servers);
     void start();
     void stop();
+    // Rebuild the cached responses from the server map, on the thread that has just changed it
     void cacheUpdated();
 
 private:
+    // Complete HTTP responses, built once for every change instead of once for every request
+    struct Cache
+    {
+        std::string servers;
+        std::string serversGzip;
+        std::string info;
+    };
+
     HttpServer httpServer;
-    MasterServer::ServerMap *serverMap;
-    bool updatedCache = true;
+    ServerRegistry *servers;
+    std::mutex cacheMutex;
+    // Only accessed through std::atomic_load and std::atomic_store, so requests can keep using the
+    // responses they got while newer ones replace them
+    std::shared_ptr<const Cache> cache;
 };
 
 
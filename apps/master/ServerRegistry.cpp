@@ -0,0 +1,305 @@
+#include "ServerRegistry.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace chrono;
+
+ServerRegistry::ServerRegistry(Clock::duration timeout) : timeout(timeout), epoch(Clock::now()), version(0),
+    oldestRevision(0), lastExpiredTick(0)
+{
+    random_device device;
+    do
+        instance = device();
+    while (instance == 0);
+}
+
+ServerRegistry::Shard &ServerRegistry::GetShard(const RakNet::SystemAddress &addr)
+{
+    return shards[AddressHash()(addr) % shardCount];
+}
+
+const ServerRegistry::Shard &ServerRegistry::GetShard(const RakNet::SystemAddress &addr) const
+{
+    return shards[AddressHash()(addr) % shardCount];
+}
+
+bool ServerRegistry::Set(const RakNet::SystemAddress &addr, const Server &server)
+{
+    Shard &shard = GetShard(addr);
+    lock_guard<mutex> lock(shard.mutex);
+
+    auto it = shard.servers.find(addr);
+    bool added = it == shard.servers.end();
+
+    uint64_t revision = version.fetch_add(1, memory_order_acq_rel) + 1;
+
+    if (added)
+        shard.servers.insert({addr, {server, revision, Schedule(addr, server.lastUpdate)}});
+    else
+    {
+        it->second.server = server;
+        it->second.revision = revision;
+    }
+
+    return added;
+}
+
+bool ServerRegistry::Touch(const RakNet::SystemAddress &addr, Clock::time_point time)
+{
+    Shard &shard = GetShard(addr);
+    lock_guard<mutex> lock(shard.mutex);
+
+    auto it = shard.servers.find(addr);
+    if (it == shard.servers.end())
+        return false;
+
+    // The server's wheel entry notices the later update once it comes up, and moves along instead of expiring it
+    it->second.server.lastUpdate = time;
+    return true;
+}
+
+bool ServerRegistry::Erase(const RakNet::SystemAddress &addr)
+{
+    Shard &shard = GetShard(addr);
+    lock_guard<mutex> lock(shard.mutex);
+
+    if (shard.servers.erase(addr) == 0)
+        return false;
+
+    AddRemoval(addr);
+    return true;
+}
+
+bool ServerRegistry::Find(const RakNet::SystemAddress &addr, Server &server) const
+{
+    const Shard &shard = GetShard(addr);
+    lock_guard<mutex> lock(shard.mutex);
+
+    auto it = shard.servers.find(addr);
+    if (it == shard.servers.end())
+        return false;
+
+    server = it->second.server;
+    return true;
+}
+
+bool ServerRegistry::Contains(const RakNet::SystemAddress &addr) const
+{
+    const Shard &shard = GetShard(addr);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.servers.find(addr) != shard.servers.end();
+}
+
+size_t ServerRegistry::Size() const
+{
+    size_t size = 0;
+
+    for (const Shard &shard : shards)
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        size += shard.servers.size();
+    }
+
+    return size;
+}
+
+void ServerRegistry::AddRemoval(const RakNet::SystemAddress &addr)
+{
+    uint64_t revision = version.fetch_add(1, memory_order_acq_rel) + 1;
+
+    lock_guard<mutex> lock(removalMutex);
+    removals.push_back({revision, addr});
+
+    if (removals.size() > maxRemovals)
+    {
+        oldestRevision = removals.front().revision;
+        removals.pop_front();
+    }
+}
+
+shared_ptr<const ServerRegistry::Snapshot> ServerRegistry::GetSnapshotData()
+{
+    uint64_t currentVersion = version.load(memory_order_acquire);
+    shared_ptr<const Snapshot> current = atomic_load(&snapshot);
+
+    if (current && current->version == currentVersion)
+        return current;
+
+    // Let a single reader rebuild it while the others wait for the result
+    lock_guard<mutex> lock(snapshotMutex);
+
+    currentVersion = version.load(memory_order_acquire);
+    current = atomic_load(&snapshot);
+
+    if (current && current->version == currentVersion)
+        return current;
+
+    // Changes made while copying raise the version again, so they make the next call rebuild it, and
+    // clients asking for the changes since this version get them again
+    auto newSnapshot = make_shared<Snapshot>();
+    newSnapshot->version = currentVersion;
+
+    for (const Shard &shard : shards)
+    {
+        lock_guard<mutex> shardLock(shard.mutex);
+
+        for (const auto &entry : shard.servers)
+        {
+            newSnapshot->servers.emplace(entry.first, static_cast<const QueryData &>(entry.second.server));
+            newSnapshot->revisions.emplace(entry.first, entry.second.revision);
+        }
+    }
+
+    {
+        lock_guard<mutex> removalLock(removalMutex);
+        newSnapshot->removals.assign(removals.begin(), removals.end());
+        newSnapshot->oldestRevision = oldestRevision;
+    }
+
+    current = move(newSnapshot);
+    atomic_store(&snapshot, current);
+    return current;
+}
+
+shared_ptr<const ServerRegistry::QueryMap> ServerRegistry::GetSnapshot()
+{
+    shared_ptr<const Snapshot> current = GetSnapshotData();
+    return shared_ptr<const QueryMap>(current, &current->servers);
+}
+
+void ServerRegistry::GetChanges(const QueryDeltaRequest &request, QueryDeltaResponse &response)
+{
+    shared_ptr<const Snapshot> current = GetSnapshotData();
+
+    // Clients that cannot be told everything that was removed since their revision get every server instead.
+    // Removals are only listed on the first page, so later pages do not need to have them remembered
+    bool isComplete = request.instance != instance || request.revision == 0 || request.revision > current->version ||
+        (!request.hasCursor && request.revision < current->oldestRevision);
+    uint64_t since = isComplete ? 0 : request.revision;
+
+    response.instance = instance;
+    response.revision = current->version;
+    response.isComplete = isComplete;
+    response.hasMore = false;
+    response.removed.clear();
+    response.servers.clear();
+
+    if (!isComplete && !request.hasCursor)
+    {
+        for (const Removal &removal : current->removals)
+        {
+            if (removal.revision > since)
+                response.removed.push_back(removal.addr);
+        }
+    }
+
+    uint32_t limit = request.limit > QueryDeltaRequest::maxLimit ? QueryDeltaRequest::maxLimit : request.limit;
+    if (limit == 0)
+        limit = 1;
+    uint32_t listed = 0;
+
+    auto serverIt = request.hasCursor ? current->servers.upper_bound(request.cursor) : current->servers.begin();
+    auto revisionIt = request.hasCursor ? current->revisions.upper_bound(request.cursor) : current->revisions.begin();
+
+    for (; serverIt != current->servers.end(); ++serverIt, ++revisionIt)
+    {
+        if (revisionIt->second <= since)
+            continue;
+
+        bool isMatch = request.filter.Matches(serverIt->second);
+
+        // Clients getting every server have nothing to drop
+        if (!isMatch && isComplete)
+            continue;
+
+        if (listed == limit)
+        {
+            response.hasMore = true;
+            break;
+        }
+
+        if (isMatch)
+            response.servers.emplace(serverIt->first, serverIt->second);
+        else
+            response.removed.push_back(serverIt->first);
+
+        response.cursor = serverIt->first;
+        listed++;
+    }
+}
+
+long long ServerRegistry::GetTick(Clock::time_point time) const
+{
+    return duration_cast<seconds>(time - epoch).count();
+}
+
+long long ServerRegistry::Schedule(const RakNet::SystemAddress &addr, Clock::time_point lastUpdate)
+{
+    // Round up, so a server is never looked at before it can have expired
+    long long tick = GetTick(lastUpdate + timeout) + 1;
+
+    lock_guard<mutex> lock(wheelMutex);
+
+    // Keep it within a single turn of the wheel ahead of the last tick handled, looking at it again then
+    // if it turns out to be further away
+    tick = min(max(tick, lastExpiredTick + 1), lastExpiredTick + (long long) wheelSize - 1);
+    wheel[tick % wheelSize].push_back({addr, tick});
+    return tick;
+}
+
+size_t ServerRegistry::Expire(Clock::time_point now)
+{
+    vector<WheelEntry> due;
+    long long nowTick = GetTick(now);
+
+    {
+        lock_guard<mutex> lock(wheelMutex);
+
+        if (nowTick <= lastExpiredTick)
+            return 0;
+
+        // After a long pause, going over every slot once is enough
+        long long firstTick = max(lastExpiredTick + 1, nowTick - (long long) wheelSize + 1);
+
+        for (long long tick = firstTick; tick <= nowTick; tick++)
+        {
+            vector<WheelEntry> &slot = wheel[tick % wheelSize];
+
+            auto later = partition(slot.begin(), slot.end(), [nowTick](const WheelEntry &entry) {
+                return entry.tick <= nowTick;
+            });
+
+            due.insert(due.end(), slot.begin(), later);
+            slot.erase(slot.begin(), later);
+        }
+
+        lastExpiredTick = nowTick;
+    }
+
+    size_t expired = 0;
+
+    for (const WheelEntry &entry : due)
+    {
+        Shard &shard = GetShard(entry.addr);
+        lock_guard<mutex> lock(shard.mutex);
+
+        auto it = shard.servers.find(entry.addr);
+
+        // Left behind by a server that has since been removed, or removed and added again
+        if (it == shard.servers.end() || it->second.expiryTick != entry.tick)
+            continue;
+
+        if (it->second.server.lastUpdate + timeout <= now)
+        {
+            shard.servers.erase(it);
+            AddRemoval(entry.addr);
+            expired++;
+        }
+        else
+            it->second.expiryTick = Schedule(entry.addr, it->second.server.lastUpdate);
+    }
+
+    return expired;
+}
@@ -0,0 +1,171 @@
+#ifndef NEWMASTERPROTO_SERVERREGISTRY_HPP
+#define NEWMASTERPROTO_SERVERREGISTRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <RakNetTypes.h>
+#include <components/openmw-mp/Master/MasterData.hpp>
+
+/*
+ * The servers known to the master, shared between the master thread and the REST server's threads
+ *
+ * Servers are spread over shards with a lock each, so announces and lookups for different servers rarely
+ * wait for each other. Whole lists are read through immutable snapshots that only get rebuilt after the
+ * query data of a server has changed, and expiry is driven by a timer wheel with one slot per second
+ * instead of a scan over every server
+ *
+ * Every change to the query data of a server gets a new revision, and the servers removed recently are
+ * remembered with theirs, so clients can be sent just what has changed since the revision they last saw
+ */
+class ServerRegistry
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Server : QueryData
+    {
+        Clock::time_point lastUpdate;
+    };
+
+    typedef std::map<RakNet::SystemAddress, QueryData> QueryMap;
+
+    explicit ServerRegistry(Clock::duration timeout);
+
+    // Add a server or replace its data, returning true if it was added
+    bool Set(const RakNet::SystemAddress &addr, const Server &server);
+    // Mark a server as updated at this time without changing its data, returning false if it is unknown
+    bool Touch(const RakNet::SystemAddress &addr, Clock::time_point time);
+    bool Erase(const RakNet::SystemAddress &addr);
+
+    // Change the data of a server through func, called with the server's shard locked
+    template<typename Function>
+    bool Modify(const RakNet::SystemAddress &addr, Function func)
+    {
+        Shard &shard = GetShard(addr);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.servers.find(addr);
+        if (it == shard.servers.end())
+            return false;
+
+        func(it->second.server);
+        it->second.revision = version.fetch_add(1, std::memory_order_acq_rel) + 1;
+        return true;
+    }
+
+    // Copy the data of a server, returning false if it is unknown
+    bool Find(const RakNet::SystemAddress &addr, Server &server) const;
+    bool Contains(const RakNet::SystemAddress &addr) const;
+    size_t Size() const;
+
+    // Visit every server with its shard locked, one shard after another
+    template<typename Function>
+    void ForEach(Function func) const
+    {
+        for (const Shard &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            for (const auto &entry : shard.servers)
+                func(entry.first, entry.second.server);
+        }
+    }
+
+    // Get the query data of every server, shared with other readers until a server's data changes
+    std::shared_ptr<const QueryMap> GetSnapshot();
+
+    // Get a page of the servers that have changed since the revision of the request
+    void GetChanges(const QueryDeltaRequest &request, QueryDeltaResponse &response);
+
+    // Remove the servers that have not been updated within the timeout, returning how many there were
+    size_t Expire(Clock::time_point now);
+
+private:
+    static const size_t shardCount = 16;
+    static const size_t wheelSize = 128;
+    // Clients whose revisions are older than the oldest removal remembered get every server again
+    static const size_t maxRemovals = 4096;
+
+    struct Entry
+    {
+        Server server;
+        uint64_t revision;
+        // Wheel tick of the only wheel entry for this server that is still valid
+        long long expiryTick;
+    };
+
+    struct AddressHash
+    {
+        size_t operator()(const RakNet::SystemAddress &addr) const
+        {
+            return RakNet::SystemAddress::ToInteger(addr);
+        }
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<RakNet::SystemAddress, Entry, AddressHash> servers;
+    };
+
+    struct WheelEntry
+    {
+        RakNet::SystemAddress addr;
+        long long tick;
+    };
+
+    struct Removal
+    {
+        uint64_t revision;
+        RakNet::SystemAddress addr;
+    };
+
+    struct Snapshot
+    {
+        uint64_t version;
+        QueryMap servers;
+        // The revision of every server in servers
+        std::map<RakNet::SystemAddress, uint64_t> revisions;
+        std::vector<Removal> removals;
+        uint64_t oldestRevision;
+    };
+
+    Shard &GetShard(const RakNet::SystemAddress &addr);
+    const Shard &GetShard(const RakNet::SystemAddress &addr) const;
+
+    std::shared_ptr<const Snapshot> GetSnapshotData();
+    // Remember that a server was removed, with its shard locked
+    void AddRemoval(const RakNet::SystemAddress &addr);
+
+    long long GetTick(Clock::time_point time) const;
+    // Pick the tick at which a server updated at this time expires, and put it in the wheel, with its shard locked
+    long long Schedule(const RakNet::SystemAddress &addr, Clock::time_point lastUpdate);
+
+    Clock::duration timeout;
+    Clock::time_point epoch;
+
+    Shard shards[shardCount];
+    // Only changes when the query data of servers or the servers themselves change, not on keep-alives
+    std::atomic<uint64_t> version;
+    // Tells clients whether their revisions are from the current list, or from one before a restart
+    uint32_t instance;
+
+    std::mutex removalMutex;
+    std::deque<Removal> removals;
+    uint64_t oldestRevision;
+
+    std::mutex wheelMutex;
+    std::vector<WheelEntry> wheel[wheelSize];
+    long long lastExpiredTick;
+
+    std::mutex snapshotMutex;
+    std::shared_ptr<const Snapshot> snapshot;
+};
+
+#endif //NEWMASTERPROTO_SERVERREGISTRY_HPP
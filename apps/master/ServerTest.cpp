@@ -1,6 +1,10 @@
 #include <RakPeerInterface.h>
 #include <RakSleep.h>
 #include <BitStream.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <Kbhit.h>
 #include <Gets.h>
@@ -8,14 +12,216 @@
 #include <components/openmw-mp/Master/PacketMasterAnnounce.hpp>
 #include <components/openmw-mp/Master/PacketMasterUpdate.hpp>
 #include <components/openmw-mp/Master/PacketMasterQuery.hpp>
+#include <components/openmw-mp/Master/PacketMasterQueryDelta.hpp>
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include "ServerRegistry.hpp"
 
 using namespace std;
 using namespace RakNet;
 using namespace mwmp;
 
-int main()
+// Serialize a packet and read it back in through the same packet, returning the size it had
+static size_t RoundTrip(BasePacket &packet, const function<void()> &prepareRead)
 {
+    BasePacket::SerializedPacket bytes = packet.Serialize();
+
+    BitStream data(const_cast<unsigned char *>(bytes->data()), bytes->size(), false);
+    unsigned char packetID;
+    data.Read(packetID);
+
+    prepareRead();
+    packet.SetReadStream(&data);
+    packet.Read();
+    return bytes->size();
+}
+
+// Ask for every page of changes the way a client does, returning how many bytes went back and forth
+static size_t QueryChanges(ServerRegistry &registry, PacketMasterQueryDelta &packet, QueryDeltaRequest request,
+    map<SystemAddress, QueryData> &cache, uint32_t &instance, uint64_t &revision)
+{
+    size_t bytes = 0;
+    bool isFirstPage = true;
+    uint64_t newRevision = 0;
+    QueryDeltaResponse response;
+
+    request.instance = instance;
+    request.revision = revision;
+
+    do
+    {
+        QueryDeltaRequest received;
+        packet.SetRequest(&request);
+        bytes += RoundTrip(packet, [&]() { packet.SetRequest(&received); });
+
+        QueryDeltaResponse sent;
+        registry.GetChanges(received, sent);
+        packet.SetResponse(&sent);
+        bytes += RoundTrip(packet, [&]() { packet.SetResponse(&response); });
+
+        if (isFirstPage)
+        {
+            if (response.isComplete)
+            {
+                cache.clear();
+                request.revision = 0;
+            }
+            instance = response.instance;
+            newRevision = response.revision;
+            isFirstPage = false;
+        }
+
+        for (const auto &addr : response.removed)
+            cache.erase(addr);
+        for (auto &server : response.servers)
+            cache[server.first] = move(server.second);
+
+        request.hasCursor = response.hasMore;
+        request.cursor = response.cursor;
+    }
+    while (response.hasMore);
+
+    revision = newRevision;
+    return bytes;
+}
+
+/*
+    Measure how fast the master answers queries about a large number of servers
+
+    Runs in a single process against a ServerRegistry of simulated servers, because the master tells servers
+    apart by the address their announcements come from and disconnects clients after answering them
+*/
+static void StressTest(unsigned int serverCount)
+{
+    typedef chrono::steady_clock Clock;
+    const int iterations = 100;
+
+    ServerRegistry registry(chrono::hours(1));
+    const Clock::time_point now = Clock::now();
+
+    for (unsigned int i = 0; i < serverCount; i++)
+    {
+        ServerRegistry::Server server;
+        server.SetName(("Stress Server " + to_string(i)).c_str());
+        server.SetVersion(i % 4 == 0 ? "0.7.0" : "0.8.1");
+        server.SetMaxPlayers(32);
+        server.SetPlayers(i % 33);
+        server.SetPassword(i % 5 == 0);
+        server.lastUpdate = now;
+
+        string addr = "10." + to_string((i >> 16) & 0xFF) + "." + to_string((i >> 8) & 0xFF) + "." + to_string(i & 0xFF);
+        registry.Set(SystemAddress(addr.c_str(), 25565), server);
+    }
+
+    auto report = [](const char *name, Clock::duration time, size_t bytes) {
+        double milliseconds = chrono::duration<double, milli>(time).count() / iterations;
+        cout << name << ": " << milliseconds << " ms and " << bytes / iterations << " bytes per query, "
+             << (milliseconds > 0 ? 1000 / milliseconds : 0) << " queries per second" << endl;
+    };
+
+    cout << "Stress testing with " << serverCount << " servers and " << iterations << " queries each" << endl;
+
+    PacketMasterQuery pmq(nullptr);
+    size_t bytes = 0;
+    Clock::time_point start = Clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        auto snapshot = registry.GetSnapshot();
+        map<SystemAddress, QueryData> received;
+        pmq.SetServers(const_cast<ServerRegistry::QueryMap *>(snapshot.get()));
+        bytes += RoundTrip(pmq, [&]() { pmq.SetServers(&received); });
+    }
+
+    report("Full query", Clock::now() - start, bytes);
+
+    PacketMasterQueryDelta pmqd(nullptr);
+    map<SystemAddress, QueryData> cache;
+    uint32_t instance = 0;
+    uint64_t revision = 0;
+
+    bytes = 0;
+    start = Clock::now();
+
+    // Start from nothing every time, the way a client does on its first refresh
+    for (int i = 0; i < iterations; i++)
+    {
+        cache.clear();
+        instance = 0;
+        revision = 0;
+        bytes += QueryChanges(registry, pmqd, QueryDeltaRequest(), cache, instance, revision);
+    }
+
+    report("First paged delta query", Clock::now() - start, bytes);
+
+    // Change a hundredth of the servers between queries, the way player counts change between refreshes
+    vector<SystemAddress> addresses;
+    registry.ForEach([&](const SystemAddress &addr, const ServerRegistry::Server &) { addresses.push_back(addr); });
+
+    const size_t changes = max<size_t>(1, addresses.size() / 100);
+    Clock::duration time = Clock::duration::zero();
+    bytes = 0;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (size_t j = 0; j < changes; j++)
+        {
+            registry.Modify(addresses[(i * changes + j) % addresses.size()], [](ServerRegistry::Server &server) {
+                server.SetPlayers((server.GetPlayers() + 1) % (server.GetMaxPlayers() + 1));
+            });
+        }
+
+        start = Clock::now();
+        bytes += QueryChanges(registry, pmqd, QueryDeltaRequest(), cache, instance, revision);
+        time += Clock::now() - start;
+    }
+
+    report("Delta query with 1% changed", time, bytes);
+
+    auto snapshot = registry.GetSnapshot();
+    bool isConsistent = cache.size() == snapshot->size();
+
+    for (const auto &server : *snapshot)
+    {
+        auto it = cache.find(server.first);
+        if (it == cache.end() || it->second.GetPlayers() != server.second.GetPlayers())
+            isConsistent = false;
+    }
+
+    cout << "Cached servers " << (isConsistent ? "match" : "do not match") << " the master's" << endl;
+
+    QueryDeltaRequest filtered;
+    filtered.limit = 100;
+    filtered.filter.version = "0.8.1";
+    filtered.filter.hideFull = true;
+    filtered.filter.password = QueryFilter::WITHOUT_PASSWORD;
+
+    bytes = 0;
+    start = Clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        QueryDeltaRequest received;
+        QueryDeltaResponse sent, response;
+
+        pmqd.SetRequest(&filtered);
+        bytes += RoundTrip(pmqd, [&]() { pmqd.SetRequest(&received); });
+
+        registry.GetChanges(received, sent);
+        pmqd.SetResponse(&sent);
+        bytes += RoundTrip(pmqd, [&]() { pmqd.SetResponse(&response); });
+    }
+
+    report("Filtered page of 100", Clock::now() - start, bytes);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "stress") == 0)
+    {
+        StressTest(argc > 2 ? (unsigned int) atoi(argv[2]) : 5000);
+        return 0;
+    }
+
     cout << "Server test" << endl;
 
     SystemAddress masterAddr("127.0.0.1", 25560);
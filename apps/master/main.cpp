@@ -15,6 +15,7 @@ int main()
 {
     masterServer.reset(new MasterServer(2000, 25560));
     restServer.reset(new RestServer(8080, masterServer->GetServers()));
+    masterServer->SetUpdateCallback([]() { restServer->cacheUpdated(); });
 
     auto onExit = [](int /*sig*/){
         restServer->stop();
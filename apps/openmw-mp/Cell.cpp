@@ -3,6 +3,8 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
 #include "Player.hpp"
 #include "Script/Script.hpp"
 
@@ -74,17 +76,42 @@ void Cell::removePlayer(Player *player, bool cleanPlayer)
     }
 }
 
+void Cell::decodePositions(mwmp::BaseActorList *newActorList)
+{
+    std::vector<mwmp::BaseActor> &newActors = newActorList->baseActors;
+    size_t decodedCount = 0;
+
+    for (size_t i = 0; i < newActors.size(); i++)
+    {
+        mwmp::BaseActor &newActor = newActors[i];
+        mwmp::BaseActor *cellActor = getActor(newActor.refNum, newActor.mpNum);
+
+        // Actors we have not heard of yet start their stream with the update itself, which
+        // readActorList() then stores alongside them
+        mwmp::PositionStream &positionStream = cellActor != nullptr ? cellActor->positionStream : newActor.positionStream;
+
+        if (!positionStream.decode(newActor.positionUpdate, newActor.position, newActor.direction))
+            continue;
+
+        if (decodedCount != i)
+            newActors[decodedCount] = newActor;
+
+        decodedCount++;
+    }
+
+    newActors.resize(decodedCount);
+    newActorList->count = decodedCount;
+}
+
 void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newActorList)
 {
     for (unsigned int i = 0; i < newActorList->count; i++)
     {
-        mwmp::BaseActor newActor = newActorList->baseActors.at(i);
-        mwmp::BaseActor *cellActor;
+        const mwmp::BaseActor &newActor = newActorList->baseActors.at(i);
+        mwmp::BaseActor *cellActor = getActor(newActor.refNum, newActor.mpNum);
 
-        if (containsActor(newActor.refNum, newActor.mpNum))
+        if (cellActor != nullptr)
         {
-            cellActor = getActor(newActor.refNum, newActor.mpNum);
-
             switch (packetID)
             {
             case ID_ACTOR_POSITION:
@@ -103,62 +130,89 @@ void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newA
             }
         }
         else
+        {
+            actorIndexes[getActorKey(newActor.refNum, newActor.mpNum)] = cellActorList.baseActors.size();
             cellActorList.baseActors.push_back(newActor);
+
+            // Stored actors only ever get sent as full positions
+            cellActorList.baseActors.back().positionUpdate.type = mwmp::PositionUpdate::FULL;
+        }
     }
 
     cellActorList.count = cellActorList.baseActors.size();
 }
 
-bool Cell::containsActor(int refNum, int mpNum)
+bool Cell::containsActor(int refNum, int mpNum) const
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor actor = cellActorList.baseActors.at(i);
-
-        if (actor.refNum == refNum && actor.mpNum == mpNum)
-            return true;
-    }
-    return false;
+    return actorIndexes.find(getActorKey(refNum, mpNum)) != actorIndexes.end();
 }
 
 mwmp::BaseActor *Cell::getActor(int refNum, int mpNum)
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor *actor = &cellActorList.baseActors.at(i);
+    auto it = actorIndexes.find(getActorKey(refNum, mpNum));
 
-        if (actor->refNum == refNum && actor->mpNum == mpNum)
-            return actor;
-    }
-    return 0;
+    if (it == actorIndexes.end())
+        return 0;
+
+    return &cellActorList.baseActors[it->second];
 }
 
 void Cell::removeActors(const mwmp::BaseActorList *newActorList)
 {
-    for (std::vector<mwmp::BaseActor>::iterator it = cellActorList.baseActors.begin(); it != cellActorList.baseActors.end();)
-    {
-        int refNum = (*it).refNum;
-        int mpNum = (*it).mpNum;
+    bool foundActor = false;
 
-        bool foundActor = false;
+    // Mark the actors to be removed, then remove them in one pass that keeps the remaining
+    // actors in order
+    std::vector<bool> isRemoved(cellActorList.baseActors.size(), false);
 
-        for (unsigned int i = 0; i < newActorList->count; i++)
-        {
-            mwmp::BaseActor newActor = newActorList->baseActors.at(i);
+    for (unsigned int i = 0; i < newActorList->count; i++)
+    {
+        const mwmp::BaseActor &newActor = newActorList->baseActors.at(i);
+        auto it = actorIndexes.find(getActorKey(newActor.refNum, newActor.mpNum));
 
-            if (newActor.refNum == refNum && newActor.mpNum == mpNum)
-            {
-                it = cellActorList.baseActors.erase(it);
-                foundActor = true;
-                break;
-            }
+        if (it != actorIndexes.end())
+        {
+            isRemoved[it->second] = true;
+            foundActor = true;
         }
+    }
+
+    if (!foundActor)
+        return;
+
+    size_t keptCount = 0;
 
-        if (!foundActor)
-            it++;
+    for (size_t i = 0; i < cellActorList.baseActors.size(); i++)
+    {
+        if (isRemoved[i])
+            continue;
+
+        if (keptCount != i)
+            cellActorList.baseActors[keptCount] = std::move(cellActorList.baseActors[i]);
+
+        keptCount++;
     }
 
+    cellActorList.baseActors.erase(cellActorList.baseActors.begin() + keptCount, cellActorList.baseActors.end());
     cellActorList.count = cellActorList.baseActors.size();
+
+    rebuildActorIndexes();
+}
+
+uint64_t Cell::getActorKey(int refNum, int mpNum)
+{
+    return ((uint64_t) (uint32_t) refNum << 32) | (uint32_t) mpNum;
+}
+
+void Cell::rebuildActorIndexes()
+{
+    actorIndexes.clear();
+
+    for (size_t i = 0; i < cellActorList.baseActors.size(); i++)
+    {
+        const mwmp::BaseActor &actor = cellActorList.baseActors[i];
+        actorIndexes[getActorKey(actor.refNum, actor.mpNum)] = i;
+    }
 }
 
 RakNet::RakNetGUID *Cell::getAuthority()
@@ -186,56 +240,93 @@ void Cell::sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *bas
     if (players.empty())
         return;
 
-    std::list <Player*> plList;
+    actorPacket->setActorList(baseActorList);
 
-    for (auto pl : players)
-    {
-        if (pl != nullptr && !pl->npc.mName.empty())
-            plList.push_back(pl);
-    }
-
-    plList.sort();
-    plList.unique();
+    // Serialize the packet once and send it to every eligible guid
+    actorPacket->Send(getLoadedGuids(baseActorList->guid));
+}
 
-    for (auto pl : plList)
-    {
-        if (pl->guid == baseActorList->guid) continue;
+void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const
+{
+    if (players.empty())
+        return;
 
-        actorPacket->setActorList(baseActorList);
+    objectPacket->setObjectList(baseObjectList);
 
-        // Send the packet to this eligible guid
-        actorPacket->Send(pl->guid);
-    }
+    // Serialize the packet once and send it to every eligible guid
+    objectPacket->Send(getLoadedGuids(baseObjectList->guid));
 }
 
-void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const
+void Cell::sendPositionsToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const
 {
     if (players.empty())
         return;
 
-    std::list <Player*> plList;
+    std::vector<RakNet::RakNetGUID> deltaGuids;
+    std::vector<RakNet::RakNetGUID> fullGuids;
+
+    for (auto pl : getLoadedPlayers(baseActorList->guid))
+    {
+        if (pl->usesPositionDeltas())
+            deltaGuids.push_back(pl->guid);
+        else
+            fullGuids.push_back(pl->guid);
+    }
+
+    actorPacket->setActorList(baseActorList);
+    actorPacket->Send(deltaGuids);
+
+    if (fullGuids.empty())
+        return;
+
+    for (auto &actor : baseActorList->baseActors)
+        actor.positionUpdate.type = mwmp::PositionUpdate::FULL;
+
+    actorPacket->Send(fullGuids);
+}
+
+std::vector<Player*> Cell::getLoadedPlayers(const RakNet::RakNetGUID &excludedGuid) const
+{
+    std::vector<Player*> plList;
+    plList.reserve(players.size());
 
     for (auto pl : players)
     {
-        if (pl != nullptr && !pl->npc.mName.empty())
+        if (pl != nullptr && !pl->npc.mName.empty() && pl->guid != excludedGuid)
             plList.push_back(pl);
     }
 
-    plList.sort();
-    plList.unique();
+    std::sort(plList.begin(), plList.end());
+    plList.erase(std::unique(plList.begin(), plList.end()), plList.end());
 
-    for (auto pl : plList)
-    {
-        if (pl->guid == baseObjectList->guid) continue;
+    return plList;
+}
 
-        objectPacket->setObjectList(baseObjectList);
+std::vector<RakNet::RakNetGUID> Cell::getLoadedGuids(const RakNet::RakNetGUID &excludedGuid) const
+{
+    std::vector<Player*> plList = getLoadedPlayers(excludedGuid);
 
-        // Send the packet to this eligible guid
-        objectPacket->Send(pl->guid);
-    }
+    std::vector<RakNet::RakNetGUID> guids;
+    guids.reserve(plList.size());
+
+    for (auto pl : plList)
+        guids.push_back(pl->guid);
+
+    return guids;
 }
 
 std::string Cell::getShortDescription() const
 {
     return cell.getShortDescription();
 }
+
+bool Cell::isWithinRange(const ESM::Cell &esmCell, int radius) const
+{
+    if (cell.isExterior() != esmCell.isExterior())
+        return false;
+
+    if (!cell.isExterior())
+        return cell.mName == esmCell.mName;
+
+    return std::abs(cell.mData.mX - esmCell.mData.mX) <= radius && std::abs(cell.mData.mY - esmCell.mData.mY) <= radius;
+}
@@ -2,6 +2,8 @@
 #define OPENMW_SERVERCELL_HPP
 
 #include <deque>
+#include <unordered_map>
+#include <vector>
 #include <string>
 #include <components/esm/records.hpp>
 #include <components/openmw-mp/Base/BaseActor.hpp>
@@ -26,8 +28,10 @@ public:
     void addPlayer(Player *player);
     void removePlayer(Player *player, bool cleanPlayer = true);
 
+    // Turn the position updates in an actor list into positions, dropping the ones that cannot be decoded yet
+    void decodePositions(mwmp::BaseActorList *newActorList);
     void readActorList(unsigned char packetID, const mwmp::BaseActorList *newActorList);
-    bool containsActor(int refNum, int mpNum);
+    bool containsActor(int refNum, int mpNum) const;
     mwmp::BaseActor *getActor(int refNum, int mpNum);
     void removeActors(const mwmp::BaseActorList *newActorList);
 
@@ -38,16 +42,29 @@ public:
     TPlayers getPlayers() const;
     void sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const;
     void sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const;
+    // Relay decoded position updates as they are to players using position deltas, and as full positions to the rest
+    void sendPositionsToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const;
 
     std::string getShortDescription() const;
 
+    // Whether this is the same interior as esmCell or an exterior at most radius cells away from it
+    bool isWithinRange(const ESM::Cell &esmCell, int radius) const;
+
 
 private:
+    std::vector<Player*> getLoadedPlayers(const RakNet::RakNetGUID &excludedGuid) const;
+    std::vector<RakNet::RakNetGUID> getLoadedGuids(const RakNet::RakNetGUID &excludedGuid) const;
+
+    static uint64_t getActorKey(int refNum, int mpNum);
+    void rebuildActorIndexes();
+
     TPlayers players;
     ESM::Cell cell;
 
     RakNet::RakNetGUID authorityGuid;
     mwmp::BaseActorList cellActorList;
+    // Positions of actors in cellActorList.baseActors, keyed by their refNum and mpNum
+    std::unordered_map<uint64_t, size_t> actorIndexes;
 };
 
 
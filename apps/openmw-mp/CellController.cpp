@@ -48,66 +48,42 @@ Cell *CellController::getCell(ESM::Cell *esmCell)
 
 Cell *CellController::getCellByXY(int x, int y)
 {
-    auto it = find_if(cells.begin(), cells.end(), [x, y](const Cell *c)
-    {
-        return c->cell.mData.mX == x && c->cell.mData.mY == y;
-    });
+    Cell *cell = cellIndex.getExterior(x, y);
 
-    if (it == cells.end())
-    {
+    if (cell == nullptr)
         LOG_APPEND(TimedLog::LOG_INFO, "- Attempt to get Cell at %i, %i failed!", x, y);
-        return nullptr;
-    }
 
-    return *it;
+    return cell;
 }
 
-Cell *CellController::getCellByName(std::string cellName)
+Cell *CellController::getCellByName(const std::string &cellName)
 {
-    auto it = find_if(cells.begin(), cells.end(), [cellName](const Cell *c)
-    {
-        return c->cell.mName == cellName;
-    });
+    Cell *cell = cellIndex.getInterior(cellName);
 
-    if (it == cells.end())
-    {
+    if (cell == nullptr)
         LOG_APPEND(TimedLog::LOG_INFO, "- Attempt to get Cell at %s failed!", cellName.c_str());
-        return nullptr;
-    }
 
-    return *it;
+    return cell;
 }
 
 Cell *CellController::addCell(ESM::Cell cellData)
 {
     LOG_APPEND(TimedLog::LOG_INFO, "- Loaded cells: %d", cells.size());
-    auto it = find_if(cells.begin(), cells.end(), [cellData](const Cell *c) {
-        // Currently we cannot compare because plugin lists can be loaded in different order
-        //return c->cell.sRecordId == cellData.sRecordId;
-        if (c->cell.isExterior() && cellData.isExterior())
-        {
-            if (c->cell.mData.mX == cellData.mData.mX && c->cell.mData.mY == cellData.mData.mY)
-                return true;
-        }
-        else if (c->cell.mName == cellData.mName)
-            return true;
 
-        return false;
-    });
+    // Currently we cannot compare sRecordIds because plugin lists can be loaded in different order,
+    // so cells are matched by their coordinates or names instead
+    Cell *cell = cellIndex.get(cellData);
 
-    Cell *cell;
-    if (it == cells.end())
+    if (cell == nullptr)
     {
         LOG_APPEND(TimedLog::LOG_INFO, "- Adding %s to CellController", cellData.getShortDescription().c_str());
 
         cell = new Cell(cellData);
         cells.push_back(cell);
+        cellIndex.add(cell->cell, cell);
     }
     else
-    {
         LOG_APPEND(TimedLog::LOG_INFO, "- Found %s in CellController", cellData.getShortDescription().c_str());
-        cell = *it;
-    }
 
     return cell;
 }
@@ -124,6 +100,7 @@ void CellController::removeCell(Cell *cell)
             Script::Call<Script::CallbackIdentity("OnCellDeletion")>(cell->getShortDescription().c_str());
             LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from CellController", cell->getShortDescription().c_str());
 
+            cellIndex.remove(cell->cell, cell);
             delete *it;
             it = cells.erase(it);
         }
@@ -7,6 +7,7 @@
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
 #include <components/openmw-mp/Packets/Object/ObjectPacket.hpp>
+#include <components/openmw-mp/CellIndex.hpp>
 
 class Player;
 class Cell;
@@ -34,13 +35,14 @@ public:
 
     Cell *getCell(ESM::Cell *esmCell);
     Cell *getCellByXY(int x, int y);
-    Cell *getCellByName(std::string cellName);
+    Cell *getCellByName(const std::string &cellName);
 
     void update(Player *player);
 
 private:
     static CellController *sThis;
     TContainer cells;
+    CellIndex<Cell> cellIndex;
 };
 
 #endif //OPENMW_SERVERCELLCONTROLLER_HPP
@@ -0,0 +1,121 @@
+#include "InterestManager.hpp"
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+#include "Cell.hpp"
+#include "Player.hpp"
+
+InterestManager *InterestManager::sThis = nullptr;
+
+InterestManager::InterestManager() : radius(-1)
+{
+    for (auto &packetRelevance : relevance)
+        packetRelevance = GLOBAL;
+
+    // Player stats stay global, because nothing sends them again to players who load a player's cell later
+
+    // Object changes, which clients ignore for cells they don't have loaded
+    setRelevance(ID_OBJECT_ACTIVATE, NEARBY);
+    setRelevance(ID_OBJECT_ANIM_PLAY, NEARBY);
+    setRelevance(ID_OBJECT_DELETE, NEARBY);
+    setRelevance(ID_OBJECT_DIALOGUE_CHOICE, NEARBY);
+    setRelevance(ID_OBJECT_HIT, NEARBY);
+    setRelevance(ID_OBJECT_LOCK, NEARBY);
+    setRelevance(ID_OBJECT_MISCELLANEOUS, NEARBY);
+    setRelevance(ID_OBJECT_MOVE, NEARBY);
+    setRelevance(ID_OBJECT_PLACE, NEARBY);
+    setRelevance(ID_OBJECT_RESTOCK, NEARBY);
+    setRelevance(ID_OBJECT_ROTATE, NEARBY);
+    setRelevance(ID_OBJECT_SCALE, NEARBY);
+    setRelevance(ID_OBJECT_SPAWN, NEARBY);
+    setRelevance(ID_OBJECT_STATE, NEARBY);
+    setRelevance(ID_OBJECT_TRAP, NEARBY);
+    setRelevance(ID_DOOR_STATE, NEARBY);
+    setRelevance(ID_CONTAINER, NEARBY);
+    setRelevance(ID_CLIENT_SCRIPT_LOCAL, NEARBY);
+
+    setRelevance(ID_OBJECT_SOUND, CELL);
+}
+
+InterestManager::~InterestManager()
+{
+
+}
+
+void InterestManager::create()
+{
+    assert(!sThis);
+    sThis = new InterestManager;
+}
+
+void InterestManager::destroy()
+{
+    assert(sThis);
+    delete sThis;
+    sThis = nullptr;
+}
+
+InterestManager *InterestManager::get()
+{
+    assert(sThis);
+    return sThis;
+}
+
+void InterestManager::setRadius(int radius)
+{
+    this->radius = radius;
+}
+
+int InterestManager::getRadius() const
+{
+    return radius;
+}
+
+void InterestManager::setRelevance(unsigned char packetID, Relevance relevance)
+{
+    this->relevance[packetID] = relevance;
+}
+
+InterestManager::Relevance InterestManager::getRelevance(unsigned char packetID) const
+{
+    return relevance[packetID];
+}
+
+void InterestManager::sendToInterested(mwmp::BasePacket *packet, const ESM::Cell *cell) const
+{
+    Relevance packetRelevance = getRelevance(packet->GetPacketID());
+
+    // Packets that don't say where they happened can't be narrowed down, so broadcast them
+    if (radius < 0 || packetRelevance == GLOBAL || cell == nullptr)
+    {
+        packet->Send(true);
+        return;
+    }
+
+    packet->Send(getInterestedGuids(*cell, packetRelevance == CELL ? 0 : radius, packet->getGUID()));
+}
+
+std::vector<RakNet::RakNetGUID> InterestManager::getInterestedGuids(const ESM::Cell &cell, int radius,
+    const RakNet::RakNetGUID &excludedGuid) const
+{
+    std::vector<RakNet::RakNetGUID> guids;
+
+    for (auto &player : *Players::getPlayers())
+    {
+        Player *pl = player.second;
+
+        if (pl == nullptr || pl->guid == excludedGuid || pl->getLoadState() != Player::POSTLOADED)
+            continue;
+
+        for (auto loadedCell : *pl->getCells())
+        {
+            if (loadedCell->isWithinRange(cell, radius))
+            {
+                guids.push_back(pl->guid);
+                break;
+            }
+        }
+    }
+
+    return guids;
+}
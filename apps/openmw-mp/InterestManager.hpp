@@ -0,0 +1,49 @@
+#ifndef OPENMW_INTERESTMANAGER_HPP
+#define OPENMW_INTERESTMANAGER_HPP
+
+#include <vector>
+#include <RakNetTypes.h>
+#include <components/esm/loadcell.hpp>
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+class InterestManager
+{
+private:
+    InterestManager();
+    ~InterestManager();
+
+    InterestManager(InterestManager&); // not used
+public:
+    static void create();
+    static void destroy();
+    static InterestManager *get();
+public:
+    enum Relevance
+    {
+        GLOBAL = 0, // send to every player, like RakNet's broadcast
+        CELL,       // send to players who have the cell itself loaded
+        NEARBY      // send to players who have a cell within the interest radius loaded
+    };
+
+    void setRadius(int radius);
+    int getRadius() const;
+
+    void setRelevance(unsigned char packetID, Relevance relevance);
+    Relevance getRelevance(unsigned char packetID) const;
+
+    // Send a packet about a cell to the other players it is relevant to, based on its packet ID, or to
+    // every other player if the cell is not known
+    void sendToInterested(mwmp::BasePacket *packet, const ESM::Cell *cell) const;
+
+    std::vector<RakNet::RakNetGUID> getInterestedGuids(const ESM::Cell &cell, int radius,
+        const RakNet::RakNetGUID &excludedGuid) const;
+
+private:
+    static InterestManager *sThis;
+
+    // A negative radius disables interest management and broadcasts everything
+    int radius;
+    Relevance relevance[256];
+};
+
+#endif //OPENMW_INTERESTMANAGER_HPP
@@ -72,6 +72,10 @@ void MasterClient::SetModname(std::string modname)
 
 void MasterClient::SetRuleString(std::string key, std::string value)
 {
+    // Those are set through their own functions
+    if (QueryData::IsPredefinedRule(key))
+        return;
+
     mutexData.lock();
     if (queryData.rules.find(key) == queryData.rules.end() || queryData.rules[key].type != 's'
         || queryData.rules[key].str != value)
@@ -87,6 +91,9 @@ void MasterClient::SetRuleString(std::string key, std::string value)
 
 void MasterClient::SetRuleValue(std::string key, double value)
 {
+    if (QueryData::IsPredefinedRule(key))
+        return;
+
     mutexData.lock();
     if (queryData.rules.find(key) == queryData.rules.end() || queryData.rules[key].type != 'v'
         || queryData.rules[key].val != value)
@@ -128,7 +135,14 @@ bool MasterClient::Process(RakNet::Packet *packet)
         case ID_MASTER_ANNOUNCE:
             pma.SetReadStream(&rs);
             pma.Read();
-            if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_KEEP)
+            if (announceState.OnReply(pma.GetFunc()))
+            {
+                LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Master server does not support compact announcements,"
+                        " announcing the server the older way");
+                updated = true;
+            }
+            else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_KEEP ||
+                pma.GetFunc() == PacketMasterAnnounce::FUNCTION_KEEP_COMPACT)
                 LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server data successfully updated on master server");
             else if (pma.GetFunc() == PacketMasterAnnounce::FUNCTION_DELETE)
             {
@@ -214,7 +228,7 @@ void MasterClient::Thread()
             }
         }
 
-        if (updated)
+        if (updated || !announceState.IsSettled())
         {
             updated = false;
             if (pIt != players->end())
@@ -225,7 +239,7 @@ void MasterClient::Thread()
                         queryData.players.push_back(player.second->npc.mName);
                 }
             }
-            Send(PacketMasterAnnounce::FUNCTION_ANNOUNCE);
+            Send(announceState.GetAnnounceFunc());
         }
         else
             Send(PacketMasterAnnounce::FUNCTION_KEEP);
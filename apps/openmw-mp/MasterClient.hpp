@@ -7,6 +7,7 @@
 #include <components/openmw-mp/Master/MasterData.hpp>
 #include <RakString.h>
 #include <components/openmw-mp/Master/PacketMasterAnnounce.hpp>
+#include <components/openmw-mp/Master/CompactAnnounceState.hpp>
 
 class MasterClient
 {
@@ -43,6 +44,7 @@ private:
     mwmp::PacketMasterAnnounce pma;
     RakNet::BitStream writeStream;
     bool updated;
+    mwmp::CompactAnnounceState announceState;
 };
 
 
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <Script/Script.hpp>
 #include <Script/API/TimerAPI.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <csignal>
@@ -20,6 +21,8 @@
 #include "MasterClient.hpp"
 #include "Cell.hpp"
 #include "CellController.hpp"
+#include "InterestManager.hpp"
+#include "Profiler.hpp"
 #include "processors/PlayerProcessor.hpp"
 #include "processors/ActorProcessor.hpp"
 #include "processors/ObjectProcessor.hpp"
@@ -34,13 +37,14 @@ static bool dataFileEnforcementState = true;
 static bool scriptErrorIgnoringState = false;
 bool killLoop = false;
 
-Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
+Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr), packetBatcher(peer)
 {
     sThis = this;
     this->peer = peer;
     players = Players::getPlayers();
 
     CellController::create();
+    InterestManager::create();
 
     systemPacketController = new SystemPacketController(peer);
     playerPacketController = new PlayerPacketController(peer);
@@ -55,6 +59,19 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     objectPacketController->SetStream(0, &bsOut);
     worldstatePacketController->SetStream(0, &bsOut);
 
+    systemPacketController->SetBatcher(&packetBatcher);
+    playerPacketController->SetBatcher(&packetBatcher);
+    actorPacketController->SetBatcher(&packetBatcher);
+    objectPacketController->SetBatcher(&packetBatcher);
+    worldstatePacketController->SetBatcher(&packetBatcher);
+
+    packetDecoder = nullptr;
+    positionEncodings = 0;
+
+    peer->AttachPlugin(&packetNotifier);
+    setLoopPacing(0, 10);
+    resetLoopStats();
+
     running = true;
     exitCode = 0;
 
@@ -63,14 +80,29 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     serverPassword = TES3MP_DEFAULT_PASSW;
 
     ProcessorInitializer();
+    initDispatchTable();
+}
+
+void Networking::setDecoderThreads(int threadCount)
+{
+    delete packetDecoder;
+    packetDecoder = threadCount > 0 ? new PacketDecoder(peer, (unsigned int) threadCount) : nullptr;
 }
 
 Networking::~Networking()
 {
     Script::Call<Script::CallbackIdentity("OnServerExit")>(false);
+    packetBatcher.flush(true);
 
+    for (auto packet : unpackedPackets)
+        peer->DeallocatePacket(packet);
+
+    InterestManager::destroy();
     CellController::destroy();
 
+    delete packetDecoder;
+    peer->DetachPlugin(&packetNotifier);
+
     sThis = 0;
     delete systemPacketController;
     delete playerPacketController;
@@ -130,6 +162,11 @@ void Networking::processSystemPacket(RakNet::Packet *packet)
             }
         }
         player->setHandshake();
+
+        // Reply with the position encodings we accept, which the client then uses for this connection
+        baseSystem.positionEncodings &= positionEncodings;
+        player->setPositionEncodings(baseSystem.positionEncodings);
+        myPacket->Send(packet->guid);
         return;
     }
 }
@@ -165,6 +202,7 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
         {
             playerPacketController->GetPacket(ID_USER_DISCONNECTED)->setPlayer(Players::getPlayer(packet->guid));
             playerPacketController->GetPacket(ID_USER_DISCONNECTED)->Send(false);
+            Profiler::removePlayer(packet->guid);
             Players::deletePlayer(packet->guid);
             return;
         }
@@ -193,38 +231,74 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
 
 }
 
-void Networking::processActorPacket(RakNet::Packet *packet)
+void Networking::processActorPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ActorProcessor::Process(*packet, baseActorList))
+    bool isHandled;
+
+    if (decoded != nullptr && decoded->type == PacketDecoder::ACTOR_PACKET)
+    {
+        // Swapping avoids copying the list, and the decoder resets what it gets back before reading
+        // another packet into it
+        std::swap(baseActorList, decoded->actorList);
+        isHandled = ActorProcessor::Dispatch(*packet, baseActorList);
+    }
+    else
+        isHandled = ActorProcessor::Process(*packet, baseActorList);
+
+    if (!isHandled)
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processObjectPacket(RakNet::Packet *packet)
+void Networking::processObjectPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ObjectProcessor::Process(*packet, baseObjectList))
+    bool isHandled;
+
+    if (decoded != nullptr && decoded->type == PacketDecoder::OBJECT_PACKET)
+    {
+        // Swapping avoids copying the list, and the decoder resets what it gets back before reading
+        // another packet into it
+        std::swap(baseObjectList, decoded->objectList);
+        isHandled = ObjectProcessor::Dispatch(*packet, baseObjectList);
+    }
+    else
+        isHandled = ObjectProcessor::Process(*packet, baseObjectList);
+
+    if (!isHandled)
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processWorldstatePacket(RakNet::Packet *packet)
+void Networking::processWorldstatePacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!WorldstateProcessor::Process(*packet, baseWorldstate))
+    bool isHandled;
+
+    if (decoded != nullptr && decoded->type == PacketDecoder::WORLDSTATE_PACKET)
+    {
+        // Swapping avoids copying the list, and the decoder resets what it gets back before reading
+        // another packet into it
+        std::swap(baseWorldstate, decoded->worldstate);
+        isHandled = WorldstateProcessor::Dispatch(*packet, baseWorldstate);
+    }
+    else
+        isHandled = WorldstateProcessor::Process(*packet, baseWorldstate);
+
+    if (!isHandled)
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled WorldstatePacket with identifier %i has arrived", packet->data[0]);
 
 }
@@ -302,35 +376,56 @@ bool Networking::preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn)
     return false;
 }
 
-void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn)
+void Networking::initDispatchTable()
 {
-    if (systemPacketController->ContainsPacket(packet->data[0]))
-    {
-        systemPacketController->SetStream(&bsIn, nullptr);
-        processSystemPacket(packet);
-    }
-    else if (playerPacketController->ContainsPacket(packet->data[0]))
+    for (unsigned int id = 0; id < 256; id++)
     {
-        playerPacketController->SetStream(&bsIn, nullptr);
-        processPlayerPacket(packet);
+        PacketDispatch &dispatch = dispatchTable[id];
+        RakNet::MessageID packetID = (RakNet::MessageID) id;
+
+        if (systemPacketController->ContainsPacket(packetID))
+            dispatch = {SYSTEM_PACKET, systemPacketController->GetPacket(packetID)};
+        else if (playerPacketController->ContainsPacket(packetID))
+            dispatch = {PLAYER_PACKET, playerPacketController->GetPacket(packetID)};
+        else if (actorPacketController->ContainsPacket(packetID))
+            dispatch = {ACTOR_PACKET, actorPacketController->GetPacket(packetID)};
+        else if (objectPacketController->ContainsPacket(packetID))
+            dispatch = {OBJECT_PACKET, objectPacketController->GetPacket(packetID)};
+        else if (worldstatePacketController->ContainsPacket(packetID))
+            dispatch = {WORLDSTATE_PACKET, worldstatePacketController->GetPacket(packetID)};
+        else
+            dispatch = {UNHANDLED_PACKET, nullptr};
     }
-    else if (actorPacketController->ContainsPacket(packet->data[0]))
-    {
-        actorPacketController->SetStream(&bsIn, 0);
-        processActorPacket(packet);
-    }
-    else if (objectPacketController->ContainsPacket(packet->data[0]))
-    {
-        objectPacketController->SetStream(&bsIn, 0);
-        processObjectPacket(packet);
-    }
-    else if (worldstatePacketController->ContainsPacket(packet->data[0]))
+}
+
+void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn, PacketDecoder::DecodedPacket *decoded)
+{
+    const PacketDispatch &dispatch = dispatchTable[packet->data[0]];
+    Profiler::PacketTimer timer(packet->data[0]);
+
+    if (dispatch.packet != nullptr)
+        dispatch.packet->SetReadStream(&bsIn);
+
+    switch (dispatch.category)
     {
-        worldstatePacketController->SetStream(&bsIn, 0);
-        processWorldstatePacket(packet);
+        case SYSTEM_PACKET:
+            processSystemPacket(packet);
+            break;
+        case PLAYER_PACKET:
+            processPlayerPacket(packet);
+            break;
+        case ACTOR_PACKET:
+            processActorPacket(packet, decoded);
+            break;
+        case OBJECT_PACKET:
+            processObjectPacket(packet, decoded);
+            break;
+        case WORLDSTATE_PACKET:
+            processWorldstatePacket(packet, decoded);
+            break;
+        default:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
     }
-    else
-        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
 }
 
 void Networking::newPlayer(RakNet::RakNetGUID guid)
@@ -381,6 +476,8 @@ void Networking::newPlayer(RakNet::RakNetGUID guid)
 
 void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
 {
+    Profiler::removePlayer(guid);
+
     Player *player = Players::getPlayer(guid);
     if (!player)
         return;
@@ -495,6 +592,60 @@ void signalHandler(int signum)
     }
 }
 
+void Networking::handlePacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded)
+{
+    if (getMasterClient()->Process(packet))
+        return;
+
+    switch (packet->data[0])
+    {
+        case ID_REMOTE_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
+            break;
+        case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
+            break;
+        }
+        case ID_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
+            break;
+        case ID_NO_FREE_INCOMING_CONNECTIONS:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
+            break;
+        case ID_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_SND_RECEIPT_ACKED:
+        case ID_CONNECTED_PING:
+        case ID_UNCONNECTED_PING:
+            break;
+        default:
+        {
+            RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+            bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+            Profiler::recordReceived(*packet);
+
+            if (Players::doesPlayerExist(packet->guid))
+                update(packet, bsIn, decoded);
+            else
+                preInit(packet, bsIn);
+            break;
+        }
+    }
+}
+
 int Networking::mainLoop()
 {
     RakNet::Packet *packet;
@@ -507,6 +658,9 @@ int Networking::mainLoop()
     sigIntHandler.sa_flags = 0;
 #endif
     
+    using Clock = std::chrono::steady_clock;
+    bool wokenByPacket = false;
+
     while (running && !killLoop)
     {
 #ifndef _WIN32
@@ -515,69 +669,138 @@ int Networking::mainLoop()
 #endif
         if (kbhit() && getch() == '\n')
             break;
-        for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
-        {
-            if (getMasterClient()->Process(packet))
-                continue;
 
-            switch (packet->data[0])
+        const Clock::time_point iterationStart = Clock::now();
+        unsigned int packetCount = 0;
+
+        if (packetDecoder)
+        {
+            // Keep the decoder threads fed while handling the packets they have read, in the order
+            // they were received
+            while (true)
             {
-                case ID_REMOTE_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
-                    break;
-                case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
-                {
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
-                    break;
-                }
-                case ID_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
-                    break;
-                case ID_NO_FREE_INCOMING_CONNECTIONS:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
-                    break;
-                case ID_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_SND_RECEIPT_ACKED:
-                case ID_CONNECTED_PING:
-                case ID_UNCONNECTED_PING:
-                    break;
-                default:
-                {
-                    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
-                    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+                while (!packetDecoder->isFull() && (packet = receive()) != nullptr)
+                    packetDecoder->push(packet);
 
+                PacketDecoder::DecodedPacket *decoded = packetDecoder->front();
 
-                    if (Players::doesPlayerExist(packet->guid))
-                        update(packet, bsIn);
-                    else
-                        preInit(packet, bsIn);
+                if (decoded == nullptr)
                     break;
-                }
+
+                packetCount++;
+                handlePacket(decoded->packet, decoded);
+                peer->DeallocatePacket(decoded->packet);
+                packetDecoder->pop();
             }
         }
+        else
+        {
+            for (packet = receive(); packet; peer->DeallocatePacket(packet), packet = receive())
+            {
+                packetCount++;
+                handlePacket(packet, nullptr);
+            }
+        }
+
+        const Clock::time_point packetsHandled = Clock::now();
         TimerAPI::Tick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        packetBatcher.flush();
+        Profiler::update();
+        const Clock::time_point timersTicked = Clock::now();
+
+        // Keep iterations at least tickInterval apart, letting packets that arrive meanwhile pile up
+        const Clock::time_point earliestNextIteration = iterationStart + tickInterval;
+        if (earliestNextIteration > timersTicked)
+            std::this_thread::sleep_until(earliestNextIteration);
+
+        // Go straight to the next iteration while packets keep coming, otherwise sleep until RakNet
+        // receives something or a timer is due
+        //
+        // RakNet wakes us up as soon as a datagram comes in, which can be slightly before it becomes
+        // available from Receive(), so retry shortly after an early wakeup instead of waiting in full
+        if (packetCount == 0)
+        {
+            Clock::time_point deadline = Clock::now() + (wokenByPacket ? std::chrono::milliseconds(1) : maximumWait);
+
+            long timeUntilNextTimer = TimerAPI::GetTimeUntilNextTimer();
+            if (timeUntilNextTimer >= 0)
+                deadline = std::min(deadline, Clock::now() + std::chrono::milliseconds(timeUntilNextTimer));
+
+            long timeUntilFlush = packetBatcher.getTimeUntilFlush();
+            if (timeUntilFlush >= 0)
+                deadline = std::min(deadline, Clock::now() + std::chrono::milliseconds(timeUntilFlush));
+
+            wokenByPacket = packetNotifier.waitUntil(deadline);
+        }
+        else
+            wokenByPacket = false;
+
+        const Clock::time_point iterationEnd = Clock::now();
+
+        typedef std::chrono::duration<double, std::milli> Milliseconds;
+        loopStats.iterations++;
+        loopStats.packets += packetCount;
+        loopStats.maxPacketsPerIteration = std::max(loopStats.maxPacketsPerIteration, packetCount);
+        loopStats.packetTime += Milliseconds(packetsHandled - iterationStart).count();
+        loopStats.timerTime += Milliseconds(timersTicked - packetsHandled).count();
+        loopStats.waitTime += Milliseconds(iterationEnd - timersTicked).count();
     }
 
     TimerAPI::Terminate();
     return exitCode;
 }
 
+RakNet::Packet *Networking::receive()
+{
+    if (unpackedPackets.empty())
+    {
+        RakNet::Packet *packet = peer->Receive();
+
+        if (packet == nullptr || packet->length == 0 || packet->data[0] != ID_PACKET_BATCH)
+            return packet;
+
+        PacketBatcher::unpack(peer, *packet, unpackedPackets);
+        peer->DeallocatePacket(packet);
+
+        if (unpackedPackets.empty())
+            return receive();
+    }
+
+    RakNet::Packet *packet = unpackedPackets.front();
+    unpackedPackets.pop_front();
+    return packet;
+}
+
+void Networking::setBatchWindow(int batchWindow)
+{
+    packetBatcher.setWindow(batchWindow);
+}
+
+void Networking::setPositionDeltas(bool enabled)
+{
+    positionEncodings = enabled ? POSITION_ENCODING_DELTA : 0;
+}
+
+void Networking::setLoopPacing(int tickInterval, int maximumWait)
+{
+    this->tickInterval = std::chrono::milliseconds(std::max(tickInterval, 0));
+    this->maximumWait = std::chrono::milliseconds(std::max(maximumWait, 1));
+}
+
+const Networking::LoopStats &Networking::getLoopStats() const
+{
+    return loopStats;
+}
+
+void Networking::resetLoopStats()
+{
+    loopStats = LoopStats();
+}
+
 void Networking::kickPlayer(RakNet::RakNetGUID guid, bool sendNotification)
 {
+    // Let the player get whatever we sent them before being kicked
+    packetBatcher.flush(true);
     peer->CloseConnection(guid, sendNotification);
 }
 
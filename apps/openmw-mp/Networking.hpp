@@ -7,7 +7,10 @@
 #include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/PacketBatcher.hpp>
 #include "Player.hpp"
+#include "PacketDecoder.hpp"
+#include "PacketNotifier.hpp"
 
 class MasterClient;
 namespace  mwmp
@@ -15,6 +18,19 @@ namespace  mwmp
     class Networking
     {
     public:
+        struct LoopStats
+        {
+            uint64_t iterations;
+            uint64_t packets;
+            unsigned int maxPacketsPerIteration;
+            // Milliseconds spent handling packets, including the script callbacks they trigger
+            double packetTime;
+            // Milliseconds spent running script timers
+            double timerTime;
+            // Milliseconds spent waiting for packets and timers
+            double waitTime;
+        };
+
         Networking(RakNet::RakPeerInterface *peer);
         ~Networking();
 
@@ -28,10 +44,10 @@ namespace  mwmp
 
         void processSystemPacket(RakNet::Packet *packet);
         void processPlayerPacket(RakNet::Packet *packet);
-        void processActorPacket(RakNet::Packet *packet);
-        void processObjectPacket(RakNet::Packet *packet);
-        void processWorldstatePacket(RakNet::Packet *packet);
-        void update(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void processActorPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded = nullptr);
+        void processObjectPacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded = nullptr);
+        void processWorldstatePacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded = nullptr);
+        void update(RakNet::Packet *packet, RakNet::BitStream &bsIn, PacketDecoder::DecodedPacket *decoded = nullptr);
 
         unsigned short numberOfConnections() const;
         unsigned int maxConnections() const;
@@ -40,6 +56,18 @@ namespace  mwmp
 
         int mainLoop();
 
+        // Read actor, object and worldstate packets on this many threads, or on the main thread if it is 0
+        void setDecoderThreads(int threadCount);
+
+        // Let clients that support it send and receive positions as quantized deltas between keyframes
+        void setPositionDeltas(bool enabled);
+
+        void setLoopPacing(int tickInterval, int maximumWait);
+        // Combine small packets sent to the same player within this many milliseconds, or not at all if it is -1
+        void setBatchWindow(int batchWindow);
+        const LoopStats &getLoopStats() const;
+        void resetLoopStats();
+
         void stopServer(int code);
 
         SystemPacketController *getSystemPacketController() const;
@@ -74,6 +102,27 @@ namespace  mwmp
 
         PacketPreInit::PluginContainer &getSamples();
     private:
+        enum PacketCategory
+        {
+            UNHANDLED_PACKET = 0,
+            SYSTEM_PACKET,
+            PLAYER_PACKET,
+            ACTOR_PACKET,
+            OBJECT_PACKET,
+            WORLDSTATE_PACKET
+        };
+
+        struct PacketDispatch
+        {
+            PacketCategory category;
+            BasePacket *packet;
+        };
+
+        void initDispatchTable();
+        // Get the next received packet, with the packets of batches returned one by one
+        RakNet::Packet *receive();
+        void handlePacket(RakNet::Packet *packet, PacketDecoder::DecodedPacket *decoded);
+
         bool preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn);
         std::string serverPassword;
         static Networking *sThis;
@@ -94,6 +143,21 @@ namespace  mwmp
         ObjectPacketController *objectPacketController;
         WorldstatePacketController *worldstatePacketController;
 
+        // Indexed directly by packet ID, so incoming packets need a single lookup to be dispatched
+        PacketDispatch dispatchTable[256];
+
+        PacketDecoder *packetDecoder;
+        // PositionEncoding bits the server accepts from clients that offer them
+        uint8_t positionEncodings;
+        PacketNotifier packetNotifier;
+        PacketBatcher packetBatcher;
+        std::deque<RakNet::Packet*> unpackedPackets;
+        // Minimum time between the starts of two loop iterations, used to batch packets together
+        std::chrono::milliseconds tickInterval;
+        // Longest wait for packets, which also bounds the delay when a wakeup from RakNet is missed
+        std::chrono::milliseconds maximumWait;
+        LoopStats loopStats;
+
         bool running;
         int exitCode;
         PacketPreInit::PluginContainer samples;
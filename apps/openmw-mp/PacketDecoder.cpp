@@ -0,0 +1,199 @@
+#include "PacketDecoder.hpp"
+
+#include <BitStream.h>
+
+#include "processors/ActorProcessor.hpp"
+#include "processors/ObjectProcessor.hpp"
+#include "processors/WorldstateProcessor.hpp"
+
+using namespace mwmp;
+
+PacketDecoder::Readers::Readers(RakNet::RakPeerInterface *peer) : actorPacketController(peer),
+    objectPacketController(peer), worldstatePacketController(peer)
+{
+
+}
+
+PacketDecoder::PacketDecoder(RakNet::RakPeerInterface *peer, unsigned int threadCount) : slots(slotCount), head(0),
+    tail(0), nextToDecode(0), idleWorkers(0), stopping(false), isFrontWaiting(false)
+{
+    mainReaders.reset(new Readers(peer));
+
+    for (unsigned int id = 0; id < 256; id++)
+    {
+        RakNet::MessageID packetID = (RakNet::MessageID) id;
+
+        if (mainReaders->actorPacketController.ContainsPacket(packetID) && ActorProcessor::HasProcessor(packetID))
+            packetTypes[id] = ACTOR_PACKET;
+        else if (mainReaders->objectPacketController.ContainsPacket(packetID) && ObjectProcessor::HasProcessor(packetID))
+            packetTypes[id] = OBJECT_PACKET;
+        else if (mainReaders->worldstatePacketController.ContainsPacket(packetID) && WorldstateProcessor::HasProcessor(packetID))
+            packetTypes[id] = WORLDSTATE_PACKET;
+        else
+            packetTypes[id] = UNREAD_PACKET;
+    }
+
+    for (auto &slot : slots)
+        slot.state = EMPTY;
+
+    for (unsigned int i = 0; i < threadCount; i++)
+        workerReaders.emplace_back(new Readers(peer));
+
+    for (unsigned int i = 0; i < threadCount; i++)
+        workers.emplace_back(&PacketDecoder::workerLoop, this, i);
+}
+
+PacketDecoder::~PacketDecoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    condition.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+bool PacketDecoder::isFull() const
+{
+    return tail.load(std::memory_order_relaxed) - head >= slotCount;
+}
+
+void PacketDecoder::push(RakNet::Packet *packet)
+{
+    uint64_t index = tail.load(std::memory_order_relaxed);
+    DecodedPacket &decoded = slots[index % slotCount];
+
+    decoded.packet = packet;
+    decoded.type = packetTypes[packet->data[0]];
+    decoded.state.store(QUEUED, std::memory_order_relaxed);
+
+    // Publishes the slot to the workers
+    tail.store(index + 1);
+
+    if (decoded.type != UNREAD_PACKET && idleWorkers.load() > 0)
+    {
+        // Lock the mutex so a worker that is about to sleep either sees the new tail or gets woken up
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+
+        condition.notify_one();
+    }
+}
+
+PacketDecoder::DecodedPacket *PacketDecoder::front()
+{
+    if (head == tail.load(std::memory_order_relaxed))
+        return nullptr;
+
+    DecodedPacket &decoded = slots[head % slotCount];
+
+    if (decoded.state.load(std::memory_order_acquire) != DECODED)
+    {
+        // Read the packet here if no worker has got to it yet, otherwise wait for the worker reading it
+        if (claim(head))
+            decode(decoded, *mainReaders);
+        else
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            isFrontWaiting = true;
+            decodedCondition.wait(lock, [&decoded] { return decoded.state.load() == DECODED; });
+            isFrontWaiting = false;
+        }
+    }
+
+    return &decoded;
+}
+
+void PacketDecoder::pop()
+{
+    DecodedPacket &decoded = slots[head % slotCount];
+
+    decoded.packet = nullptr;
+    decoded.state.store(EMPTY, std::memory_order_relaxed);
+    head++;
+}
+
+bool PacketDecoder::claim(uint64_t index)
+{
+    return nextToDecode.compare_exchange_strong(index, index + 1);
+}
+
+void PacketDecoder::workerLoop(unsigned int workerIndex)
+{
+    Readers &readers = *workerReaders[workerIndex];
+
+    while (true)
+    {
+        uint64_t index = nextToDecode.load();
+
+        if (index >= tail.load())
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            idleWorkers++;
+            condition.wait(lock, [this] { return stopping || nextToDecode.load() < tail.load(); });
+            idleWorkers--;
+
+            if (stopping)
+                return;
+
+            continue;
+        }
+
+        if (claim(index))
+            decode(slots[index % slotCount], readers);
+    }
+}
+
+void PacketDecoder::decode(DecodedPacket &decoded, Readers &readers)
+{
+    RakNet::Packet *packet = decoded.packet;
+
+    if (decoded.type != UNREAD_PACKET)
+    {
+        RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+        bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+        if (decoded.type == ACTOR_PACKET)
+        {
+            decoded.actorList = BaseActorList();
+
+            ActorPacket *myPacket = readers.actorPacketController.GetPacket(packet->data[0]);
+            myPacket->SetReadStream(&bsIn);
+            ActorProcessor::Read(*packet, decoded.actorList, *myPacket);
+        }
+        else if (decoded.type == OBJECT_PACKET)
+        {
+            decoded.objectList = BaseObjectList();
+
+            ObjectPacket *myPacket = readers.objectPacketController.GetPacket(packet->data[0]);
+            myPacket->SetReadStream(&bsIn);
+            ObjectProcessor::Read(*packet, decoded.objectList, *myPacket);
+        }
+        else
+        {
+            decoded.worldstate = BaseWorldstate();
+
+            WorldstatePacket *myPacket = readers.worldstatePacketController.GetPacket(packet->data[0]);
+            myPacket->SetReadStream(&bsIn);
+            WorldstateProcessor::Read(*packet, decoded.worldstate, *myPacket);
+        }
+    }
+
+    decoded.state.store(DECODED);
+
+    if (isFrontWaiting.load())
+    {
+        // Lock the mutex so the main thread either sees the new state or gets woken up
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+
+        decodedCondition.notify_one();
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef OPENMW_PACKETDECODER_HPP
+#define OPENMW_PACKETDECODER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <RakPeerInterface.h>
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Base/BaseWorldstate.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+
+namespace mwmp
+{
+    /*
+     * Reads actor, object and worldstate packets on worker threads while the main thread
+     * processes earlier packets and runs their script callbacks
+     *
+     * The main thread pushes every packet it receives into a ring buffer and takes them back
+     * out in the same order, so packets are still processed in the order they arrived. Worker
+     * threads claim packets from the ring through an atomic index and mark them as read with
+     * an atomic state, without taking any locks. If the main thread reaches a packet no worker
+     * has claimed yet, it reads the packet itself instead of waiting.
+     *
+     * Player packets are read straight into the state of their Player, which only the main
+     * thread can safely touch, so they are passed through unread.
+     */
+    class PacketDecoder
+    {
+    public:
+        enum PacketType
+        {
+            UNREAD_PACKET = 0,
+            ACTOR_PACKET,
+            OBJECT_PACKET,
+            WORLDSTATE_PACKET
+        };
+
+        struct DecodedPacket
+        {
+            RakNet::Packet *packet;
+            PacketType type;
+
+            // Only the member matching the type holds the packet's contents, and it is reset before
+            // each packet is read into it so nothing is left over from an earlier packet
+            BaseActorList actorList;
+            BaseObjectList objectList;
+            BaseWorldstate worldstate;
+
+        private:
+            friend class PacketDecoder;
+            std::atomic<int> state;
+        };
+
+        PacketDecoder(RakNet::RakPeerInterface *peer, unsigned int threadCount);
+        ~PacketDecoder();
+
+        bool isFull() const;
+
+        // Queue a received packet, which must not be done while isFull() is true
+        void push(RakNet::Packet *packet);
+
+        // Get the oldest queued packet once it has been read, or nullptr if there are none left
+        DecodedPacket *front();
+        // Release the packet returned by front(), whose RakNet packet the caller deallocates
+        void pop();
+
+    private:
+        enum SlotState
+        {
+            EMPTY = 0,
+            QUEUED,
+            DECODED
+        };
+
+        // Each thread reads packets through its own packet objects, because they keep pointers
+        // to the stream and list they are reading
+        struct Readers
+        {
+            explicit Readers(RakNet::RakPeerInterface *peer);
+
+            ActorPacketController actorPacketController;
+            ObjectPacketController objectPacketController;
+            WorldstatePacketController worldstatePacketController;
+        };
+
+        static const unsigned int slotCount = 256;
+
+        void workerLoop(unsigned int workerIndex);
+        bool claim(uint64_t index);
+        void decode(DecodedPacket &decoded, Readers &readers);
+
+        std::vector<DecodedPacket> slots;
+        PacketType packetTypes[256];
+
+        // Next slot for the main thread to take out, only touched by the main thread
+        uint64_t head;
+        // Next slot for the main thread to fill, published to the workers
+        std::atomic<uint64_t> tail;
+        // Next slot for any thread to read
+        std::atomic<uint64_t> nextToDecode;
+
+        std::unique_ptr<Readers> mainReaders;
+        std::vector<std::unique_ptr<Readers> > workerReaders;
+        std::vector<std::thread> workers;
+
+        // Only used to put idle workers to sleep, with idleWorkers letting push() skip the mutex
+        // while every worker is busy
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<unsigned int> idleWorkers;
+        bool stopping;
+
+        // Lets front() sleep until a worker has read the packet it needs, with isFrontWaiting letting
+        // workers skip the mutex while the main thread isn't waiting
+        std::condition_variable decodedCondition;
+        std::atomic<bool> isFrontWaiting;
+    };
+}
+
+#endif //OPENMW_PACKETDECODER_HPP
@@ -0,0 +1,38 @@
+#include "PacketNotifier.hpp"
+
+PacketNotifier::PacketNotifier() : pending(false)
+{
+
+}
+
+bool PacketNotifier::UsesReliabilityLayer() const
+{
+    // Needed for RakNet to call OnDirectSocketReceive() from its network thread
+    return true;
+}
+
+void PacketNotifier::OnDirectSocketReceive(const char *data, const RakNet::BitSize_t bitsUsed,
+    RakNet::SystemAddress remoteSystemAddress)
+{
+    notify();
+}
+
+void PacketNotifier::notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+
+    condition.notify_one();
+}
+
+bool PacketNotifier::waitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    bool notified = condition.wait_until(lock, deadline, [this] { return pending; });
+    pending = false;
+
+    return notified;
+}
@@ -0,0 +1,35 @@
+#ifndef OPENMW_PACKETNOTIFIER_HPP
+#define OPENMW_PACKETNOTIFIER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <PluginInterface2.h>
+
+/*
+ * Lets the main loop sleep until RakNet receives something instead of polling it
+ *
+ * RakNet calls plugins that use the reliability layer from its network thread for every datagram
+ * it reads from the socket, which is used here to wake up a thread waiting in waitUntil()
+ */
+class PacketNotifier : public RakNet::PluginInterface2
+{
+public:
+    PacketNotifier();
+
+    bool UsesReliabilityLayer() const override;
+    void OnDirectSocketReceive(const char *data, const RakNet::BitSize_t bitsUsed,
+        RakNet::SystemAddress remoteSystemAddress) override;
+
+    void notify();
+
+    // Block until a datagram arrives or the deadline passes, returning true in the former case
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool pending;
+};
+
+#endif //OPENMW_PACKETNOTIFIER_HPP
@@ -1,6 +1,8 @@
 #include "Player.hpp"
 #include "Networking.hpp"
 
+#include <algorithm>
+
 TPlayers Players::players;
 TSlots Players::slots;
 
@@ -68,6 +70,7 @@ Player::Player(RakNet::RakNetGUID guid) : BasePlayer(guid)
 {
     handshakeCounter = 0;
     loadState = NOTLOADED;
+    positionEncodings = 0;
 }
 
 Player::~Player()
@@ -116,6 +119,16 @@ int Player::getLoadState()
     return loadState;
 }
 
+void Player::setPositionEncodings(uint8_t encodings)
+{
+    positionEncodings = encodings;
+}
+
+bool Player::usesPositionDeltas() const
+{
+    return (positionEncodings & mwmp::POSITION_ENCODING_DELTA) != 0;
+}
+
 Player *Players::getPlayer(unsigned short id)
 {
     auto it = slots.find(id);
@@ -129,23 +142,61 @@ CellController::TContainer *Player::getCells()
     return &cells;
 }
 
-void Player::sendToLoaded(mwmp::PlayerPacket *myPacket)
+std::vector<Player*> Player::getLoadedPlayers()
 {
-    std::list <Player*> plList;
+    std::vector<Player*> plList;
 
     for (auto cell : cells)
         for (auto pl : *cell)
-            plList.push_back(pl);
+        {
+            if (pl != this)
+                plList.push_back(pl);
+        }
 
-    plList.sort();
-    plList.unique();
+    std::sort(plList.begin(), plList.end());
+    plList.erase(std::unique(plList.begin(), plList.end()), plList.end());
+
+    return plList;
+}
+
+void Player::sendToLoaded(mwmp::PlayerPacket *myPacket)
+{
+    std::vector<Player*> plList = getLoadedPlayers();
+
+    std::vector<RakNet::RakNetGUID> guids;
+    guids.reserve(plList.size());
 
     for (auto pl : plList)
+        guids.push_back(pl->guid);
+
+    // Serialize the packet once and send it to every player who has one of our cells loaded
+    myPacket->setPlayer(this);
+    myPacket->Send(guids);
+}
+
+void Player::sendPositionToLoaded(mwmp::PlayerPacket *myPacket)
+{
+    std::vector<RakNet::RakNetGUID> deltaGuids;
+    std::vector<RakNet::RakNetGUID> fullGuids;
+
+    for (auto pl : getLoadedPlayers())
     {
-        if (pl == this) continue;
-        myPacket->setPlayer(this);
-        myPacket->Send(pl->guid);
+        if (pl->usesPositionDeltas())
+            deltaGuids.push_back(pl->guid);
+        else
+            fullGuids.push_back(pl->guid);
     }
+
+    // Players using deltas get the update exactly as we received it, which keeps their copy
+    // of this player's stream in step with ours
+    myPacket->setPlayer(this);
+    myPacket->Send(deltaGuids);
+
+    if (fullGuids.empty())
+        return;
+
+    positionUpdate.type = mwmp::PositionUpdate::FULL;
+    myPacket->Send(fullGuids);
 }
 
 void Player::forEachLoaded(std::function<void(Player *pl, Player *other)> func)
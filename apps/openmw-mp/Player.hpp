@@ -62,17 +62,25 @@ public:
     void setLoadState(int state);
     int getLoadState();
 
+    void setPositionEncodings(uint8_t encodings);
+    bool usesPositionDeltas() const;
+
     virtual ~Player();
 
     CellController::TContainer *getCells();
     void sendToLoaded(mwmp::PlayerPacket *myPacket);
+    // Relay a decoded position update as it is to players using position deltas, and as a full position to the rest
+    void sendPositionToLoaded(mwmp::PlayerPacket *myPacket);
 
     void forEachLoaded(std::function<void(Player *pl, Player *other)> func);
 
 private:
+    std::vector<Player*> getLoadedPlayers();
+
     CellController::TContainer cells;
     int loadState;
     int handshakeCounter;
+    uint8_t positionEncodings;
 
 };
 
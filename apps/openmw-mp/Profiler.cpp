@@ -0,0 +1,272 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+#include "Player.hpp"
+#include "processors/PlayerProcessor.hpp"
+#include "processors/ActorProcessor.hpp"
+#include "processors/ObjectProcessor.hpp"
+#include "processors/WorldstateProcessor.hpp"
+
+bool Profiler::enabled = false;
+std::thread::id Profiler::mainThread;
+Profiler::Clock::time_point Profiler::resetTime = Profiler::Clock::now();
+
+std::vector<Profiler::CallbackStats> Profiler::callbacks;
+Profiler::PacketStats Profiler::packets[256];
+std::unordered_map<uint64_t, Profiler::PlayerStats> Profiler::players;
+
+std::string Profiler::dumpPath;
+Profiler::Clock::duration Profiler::dumpInterval = Profiler::Clock::duration::zero();
+Profiler::Clock::time_point Profiler::nextDump;
+
+typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+void Profiler::setEnabled(bool state)
+{
+    if (state == enabled)
+        return;
+
+    enabled = state;
+
+    if (enabled)
+    {
+        mainThread = std::this_thread::get_id();
+        reset();
+        nextDump = Clock::now() + dumpInterval;
+        mwmp::BasePacket::setSendObserver(recordSent);
+    }
+    else
+        mwmp::BasePacket::setSendObserver(nullptr);
+}
+
+void Profiler::setDumpFile(const std::string &path, int interval)
+{
+    dumpPath = path;
+    dumpInterval = std::chrono::seconds(std::max(interval, 0));
+    nextDump = Clock::now() + dumpInterval;
+}
+
+void Profiler::reset()
+{
+    resetTime = Clock::now();
+
+    for (auto &callback : callbacks)
+        callback = {callback.name, 0, 0, 0};
+
+    std::fill(std::begin(packets), std::end(packets), PacketStats());
+
+    for (auto &player : players)
+        player.second = PlayerStats();
+}
+
+void Profiler::removePlayer(RakNet::RakNetGUID guid)
+{
+    players.erase(guid.g);
+}
+
+double Profiler::getElapsedTime()
+{
+    return std::chrono::duration<double>(Clock::now() - resetTime).count();
+}
+
+const Profiler::PlayerStats *Profiler::getPlayerStats(RakNet::RakNetGUID guid)
+{
+    auto it = players.find(guid.g);
+    return it != players.end() ? &it->second : nullptr;
+}
+
+void Profiler::recordCallback(unsigned int slot, const char *name, Clock::duration duration)
+{
+    if (slot >= callbacks.size())
+        callbacks.resize(slot + 1, {nullptr, 0, 0, 0});
+
+    CallbackStats &callback = callbacks[slot];
+    double time = Milliseconds(duration).count();
+
+    callback.name = name;
+    callback.calls++;
+    callback.totalTime += time;
+    callback.maxTime = std::max(callback.maxTime, time);
+}
+
+void Profiler::recordHandled(RakNet::MessageID packetID, Clock::duration duration)
+{
+    PacketStats &packet = packets[packetID];
+    double time = Milliseconds(duration).count();
+
+    packet.handled++;
+    packet.totalTime += time;
+    packet.maxTime = std::max(packet.maxTime, time);
+}
+
+void Profiler::recordReceivedPacket(const RakNet::Packet &packet)
+{
+    if (packet.length == 0)
+        return;
+
+    PacketStats &stats = packets[packet.data[0]];
+    stats.received++;
+    stats.receivedBytes += packet.length;
+
+    // Only players get an entry, so packets from clients that never finish connecting can't add ones that are
+    // never removed
+    auto it = players.find(packet.guid.g);
+
+    if (it == players.end())
+    {
+        if (!Players::doesPlayerExist(packet.guid))
+            return;
+
+        it = players.emplace(packet.guid.g, PlayerStats()).first;
+    }
+
+    it->second.received++;
+    it->second.receivedBytes += packet.length;
+}
+
+void Profiler::recordSent(const char *data, unsigned int length, const RakNet::AddressOrGUID &destination,
+    bool broadcast)
+{
+    if (length == 0 || std::this_thread::get_id() != mainThread)
+        return;
+
+    PacketStats &stats = packets[(unsigned char) data[0]];
+    stats.sent++;
+    stats.sentBytes += length;
+
+    if (broadcast || destination.rakNetGuid == RakNet::UNASSIGNED_CRABNET_GUID)
+        return;
+
+    auto it = players.find(destination.rakNetGuid.g);
+
+    if (it != players.end())
+    {
+        it->second.sent++;
+        it->second.sentBytes += length;
+    }
+}
+
+static std::string getPacketName(unsigned char packetID)
+{
+    if (mwmp::PlayerProcessor::HasProcessor(packetID))
+        return mwmp::PlayerProcessor::GetProcessor(packetID)->GetNameOfID();
+    if (mwmp::ActorProcessor::HasProcessor(packetID))
+        return mwmp::ActorProcessor::GetProcessor(packetID)->GetNameOfID();
+    if (mwmp::ObjectProcessor::HasProcessor(packetID))
+        return mwmp::ObjectProcessor::GetProcessor(packetID)->GetNameOfID();
+    if (mwmp::WorldstateProcessor::HasProcessor(packetID))
+        return mwmp::WorldstateProcessor::GetProcessor(packetID)->GetNameOfID();
+
+    return "";
+}
+
+std::string Profiler::getReport()
+{
+    const double elapsed = getElapsedTime();
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "{\n  \"elapsed\": " << elapsed << ",\n  \"callbacks\": [";
+
+    bool first = true;
+
+    for (const auto &callback : callbacks)
+    {
+        if (callback.calls == 0)
+            continue;
+
+        report << (first ? "\n" : ",\n") << "    {\"name\": \"" << callback.name << "\", \"calls\": " << callback.calls
+               << ", \"totalTime\": " << callback.totalTime << ", \"maxTime\": " << callback.maxTime << "}";
+        first = false;
+    }
+
+    report << "\n  ],\n  \"packets\": [";
+    first = true;
+
+    for (unsigned int id = 0; id < 256; id++)
+    {
+        const PacketStats &packet = packets[id];
+
+        if (packet.received == 0 && packet.sent == 0)
+            continue;
+
+        report << (first ? "\n" : ",\n") << "    {\"id\": " << id << ", \"name\": \"" << getPacketName(id)
+               << "\", \"received\": " << packet.received << ", \"receivedBytes\": " << packet.receivedBytes
+               << ", \"handled\": " << packet.handled << ", \"totalTime\": " << packet.totalTime
+               << ", \"maxTime\": " << packet.maxTime << ", \"sent\": " << packet.sent
+               << ", \"sentBytes\": " << packet.sentBytes << "}";
+        first = false;
+    }
+
+    report << "\n  ],\n  \"players\": [";
+    first = true;
+
+    for (const auto &entry : players)
+    {
+        Player *player = Players::getPlayer(RakNet::RakNetGUID(entry.first));
+
+        if (player == nullptr)
+            continue;
+
+        const PlayerStats &stats = entry.second;
+
+        report << (first ? "\n" : ",\n") << "    {\"pid\": " << player->getId()
+               << ", \"received\": " << stats.received << ", \"receivedBytes\": " << stats.receivedBytes
+               << ", \"receivedPerSecond\": " << (elapsed > 0 ? stats.received / elapsed : 0)
+               << ", \"sent\": " << stats.sent << ", \"sentBytes\": " << stats.sentBytes
+               << ", \"sentPerSecond\": " << (elapsed > 0 ? stats.sent / elapsed : 0) << "}";
+        first = false;
+    }
+
+    report << "\n  ]\n}\n";
+    return report.str();
+}
+
+void Profiler::update()
+{
+    if (!enabled || dumpInterval == Clock::duration::zero() || dumpPath.empty())
+        return;
+
+    const Clock::time_point now = Clock::now();
+
+    if (now < nextDump)
+        return;
+
+    nextDump = now + dumpInterval;
+    writeReport();
+}
+
+void Profiler::writeReport()
+{
+    // Replace the previous report in one go, so anything reading it never sees half a file
+    boost::filesystem::path path(dumpPath);
+    boost::filesystem::path temporaryPath(dumpPath + ".tmp");
+
+    {
+        boost::filesystem::ofstream file(temporaryPath, std::ios::trunc);
+
+        if (!file)
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not write profiler report to %s", temporaryPath.string().c_str());
+            return;
+        }
+
+        file << getReport();
+    }
+
+    boost::system::error_code error;
+    boost::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not write profiler report to %s: %s", path.string().c_str(),
+            error.message().c_str());
+}
@@ -0,0 +1,151 @@
+#ifndef OPENMW_PROFILER_HPP
+#define OPENMW_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <RakNetTypes.h>
+
+/*
+ * Records where the server's time goes: how often and for how long every script callback runs, how many
+ * packets of every type arrive and leave and how long handling them takes, and how much every player sends
+ * and receives
+ *
+ * Everything is recorded on the main thread. While the profiler is disabled, the only cost left in the
+ * instrumented code is checking isEnabled()
+ */
+class Profiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct CallbackStats
+    {
+        const char *name;
+        uint64_t calls;
+        // Milliseconds, including any callbacks called from within this one
+        double totalTime;
+        double maxTime;
+    };
+
+    struct PacketStats
+    {
+        uint64_t received;
+        uint64_t receivedBytes;
+        uint64_t handled;
+        // Milliseconds spent handling packets of this type, including the script callbacks they trigger
+        double totalTime;
+        double maxTime;
+        // A broadcast counts as a single packet sent
+        uint64_t sent;
+        uint64_t sentBytes;
+    };
+
+    struct PlayerStats
+    {
+        uint64_t received;
+        uint64_t receivedBytes;
+        uint64_t sent;
+        uint64_t sentBytes;
+    };
+
+    // Times a single call of a script callback, if the profiler is enabled
+    class CallbackTimer
+    {
+    public:
+        CallbackTimer(unsigned int slot, const char *name) : slot(slot), name(name), started(enabled)
+        {
+            if (started)
+                start = Clock::now();
+        }
+
+        ~CallbackTimer()
+        {
+            if (started)
+                recordCallback(slot, name, Clock::now() - start);
+        }
+
+    private:
+        unsigned int slot;
+        const char *name;
+        bool started;
+        Clock::time_point start;
+    };
+
+    // Times the handling of a single received packet, if the profiler is enabled
+    class PacketTimer
+    {
+    public:
+        explicit PacketTimer(RakNet::MessageID packetID) : packetID(packetID), started(enabled)
+        {
+            if (started)
+                start = Clock::now();
+        }
+
+        ~PacketTimer()
+        {
+            if (started)
+                recordHandled(packetID, Clock::now() - start);
+        }
+
+    private:
+        RakNet::MessageID packetID;
+        bool started;
+        Clock::time_point start;
+    };
+
+    static bool isEnabled()
+    {
+        return enabled;
+    }
+
+    static void setEnabled(bool state);
+    // Write a report to this file every interval seconds while enabled, or never if the interval is 0
+    static void setDumpFile(const std::string &path, int interval);
+    static void reset();
+
+    static void recordReceived(const RakNet::Packet &packet)
+    {
+        if (enabled)
+            recordReceivedPacket(packet);
+    }
+
+    static void removePlayer(RakNet::RakNetGUID guid);
+
+    // Seconds since the statistics were last reset
+    static double getElapsedTime();
+    static const PlayerStats *getPlayerStats(RakNet::RakNetGUID guid);
+
+    // Everything recorded since the last reset, as JSON
+    static std::string getReport();
+
+    // Write the report if it is due, called once every loop iteration
+    static void update();
+
+private:
+    static void recordCallback(unsigned int slot, const char *name, Clock::duration duration);
+    static void recordHandled(RakNet::MessageID packetID, Clock::duration duration);
+    static void recordReceivedPacket(const RakNet::Packet &packet);
+    static void recordSent(const char *data, unsigned int length, const RakNet::AddressOrGUID &destination,
+        bool broadcast);
+    static void writeReport();
+
+    static bool enabled;
+    // Packets sent from other threads, such as the master server announcements, are not counted
+    static std::thread::id mainThread;
+    static Clock::time_point resetTime;
+
+    // Indexed by the callback slots handed out by Script
+    static std::vector<CallbackStats> callbacks;
+    static PacketStats packets[256];
+    static std::unordered_map<uint64_t, PlayerStats> players;
+
+    static std::string dumpPath;
+    static Clock::duration dumpInterval;
+    static Clock::time_point nextDump;
+};
+
+#endif //OPENMW_PROFILER_HPP
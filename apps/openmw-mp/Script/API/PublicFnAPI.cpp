@@ -1,42 +1,102 @@
 #include <Script/ScriptFunction.hpp>
 #include "PublicFnAPI.hpp"
 
-std::unordered_map<std::string, Public *> Public::publics;
+std::vector<Public *> Public::publics;
+std::unordered_map<std::string, int> Public::handles;
 
 Public::~Public()
 {
 
 }
 
-Public::Public(ScriptFunc _public, const std::string &name, char ret_type, const std::string &def) : ScriptFunction(_public, ret_type, def)
+Public::Public(ScriptFunc _public, char ret_type, const std::string &def) : ScriptFunction(_public, ret_type, def)
 {
-    publics.emplace(name, this);
+
 }
 
-Public::Public(ScriptFuncLua _public, lua_State *lua, const std::string &name, char ret_type, const std::string &def) : ScriptFunction(
+#if defined(ENABLE_LUA)
+Public::Public(ScriptFuncLua _public, lua_State *lua, char ret_type, const std::string &def) : ScriptFunction(
         _public, lua, ret_type, def)
 {
-    publics.emplace(name, this);
+
+}
+#endif
+
+int Public::AddPublic(const std::string &name, Public *_public)
+{
+    handles.emplace(name, (int) publics.size());
+    publics.push_back(_public);
+    return (int) publics.size() - 1;
+}
+
+Public *Public::GetPublic(int handle)
+{
+    if (handle < 0 || handle >= (int) publics.size())
+        throw std::runtime_error("Public with handle " + std::to_string(handle) + " does not exist");
+
+    return publics[handle];
+}
+
+int Public::MakePublic(ScriptFunc _public, const std::string &name, char ret_type, const std::string &def)
+{
+    int handle = GetHandle(name);
+
+    if (handle != -1)
+        return handle;
+
+    return AddPublic(name, new Public(_public, ret_type, def));
+}
+
+#if defined(ENABLE_LUA)
+int Public::MakePublic(ScriptFuncLua _public, lua_State *lua, const std::string &name, char ret_type,
+    const std::string &def)
+{
+    int handle = GetHandle(name);
+
+    if (handle != -1)
+        return handle;
+
+    return AddPublic(name, new Public(_public, lua, ret_type, def));
+}
+#endif
+
+int Public::GetHandle(const std::string &name)
+{
+    auto it = handles.find(name);
+
+    if (it == handles.end())
+        return -1;
+
+    return it->second;
+}
+
+ScriptArgument Public::Call(int handle, const ScriptArguments &args)
+{
+    return GetPublic(handle)->ScriptFunction::Call(args);
 }
 
-boost::any Public::Call(const std::string &name, const std::vector<boost::any> &args)
+ScriptArgument Public::Call(const std::string &name, const ScriptArguments &args)
 {
-    auto it = publics.find(name);
-    if (it == publics.end())
+    int handle = GetHandle(name);
+    if (handle == -1)
         throw std::runtime_error("Public with name \"" + name + "\" does not exist");
 
-    return it->second->ScriptFunction::Call(args);
+    return Call(handle, args);
 }
 
+const std::string &Public::GetDefinition(int handle)
+{
+    return GetPublic(handle)->def;
+}
 
 const std::string &Public::GetDefinition(const std::string &name)
 {
-    auto it = publics.find(name);
+    int handle = GetHandle(name);
 
-    if (it == publics.end())
+    if (handle == -1)
         throw std::runtime_error("Public with name \"" + name + "\" does not exist");
 
-    return it->second->def;
+    return GetDefinition(handle);
 }
 
 
@@ -45,20 +105,19 @@ bool Public::IsLua(const std::string &name)
 #if !defined(ENABLE_LUA)
     return false;
 #else
-    auto it = publics.find(name);
-    if (it == publics.end())
+    int handle = GetHandle(name);
+    if (handle == -1)
         throw std::runtime_error("Public with name \"" + name + "\" does not exist");
 
-    return it->second->script_type == SCRIPT_LUA;
+    return publics[handle]->script_type == SCRIPT_LUA;
 #endif
 }
 
 void Public::DeleteAll()
 {
-    for (auto it = publics.begin(); it != publics.end(); it++)
-    {
-        Public *_public = it->second;
+    for (Public *_public : publics)
         delete _public;
-        publics.erase(it);
-    }
+
+    publics.clear();
+    handles.clear();
 }
@@ -2,6 +2,7 @@
 #define PLUGINSYSTEM3_PUBLICFNAPI_HPP
 
 #include <unordered_map>
+#include <vector>
 #include <Script/ScriptFunction.hpp>
 
 
@@ -10,20 +11,35 @@ class Public : public ScriptFunction
 private:
     ~Public();
 
-    static std::unordered_map<std::string, Public *> publics;
+    // Indexed by the handles returned from MakePublic()
+    static std::vector<Public *> publics;
+    static std::unordered_map<std::string, int> handles;
 
-    Public(ScriptFunc _public, const std::string &name, char ret_type, const std::string &def);
+    Public(ScriptFunc _public, char ret_type, const std::string &def);
 #if defined(ENABLE_LUA)
-    Public(ScriptFuncLua _public, lua_State *lua, const std::string &name, char ret_type, const std::string &def);
+    Public(ScriptFuncLua _public, lua_State *lua, char ret_type, const std::string &def);
 #endif
 
+    static int AddPublic(const std::string &name, Public *_public);
+    static Public *GetPublic(int handle);
+
 public:
-    template<typename... Args>
-    static void MakePublic(Args &&... args)
-    { new Public(std::forward<Args>(args)...); }
+    // Returns the handle of the public, which stays the same for as long as the public exists
+    //
+    // A name can only be made public once, with later attempts returning the handle of the first one
+    static int MakePublic(ScriptFunc _public, const std::string &name, char ret_type, const std::string &def);
+#if defined(ENABLE_LUA)
+    static int MakePublic(ScriptFuncLua _public, lua_State *lua, const std::string &name, char ret_type,
+        const std::string &def);
+#endif
+
+    // Returns -1 if there is no public with this name
+    static int GetHandle(const std::string &name);
 
-    static boost::any Call(const std::string &name, const std::vector<boost::any> &args);
+    static ScriptArgument Call(int handle, const ScriptArguments &args);
+    static ScriptArgument Call(const std::string &name, const ScriptArguments &args);
 
+    static const std::string& GetDefinition(int handle);
     static const std::string& GetDefinition(const std::string& name);
 
     static bool IsLua(const std::string &name);
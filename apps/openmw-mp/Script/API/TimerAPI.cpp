@@ -1,41 +1,31 @@
 #include "TimerAPI.hpp"
 
-#include <chrono>
+#include <algorithm>
+#include <functional>
 
 #include <iostream>
 using namespace mwmp;
 
-Timer::Timer(ScriptFunc callback, long msec, const std::string& def, std::vector<boost::any> args) : ScriptFunction(callback, 'v', def)
+Timer::Timer(ScriptFunc callback, long msec, const std::string& def, const ScriptArguments &args) : ScriptFunction(callback, 'v', def),
+    args(args)
 {
     targetMsec = msec;
-    this->args = args;
+    this->args.KeepStrings();
     isEnded = true;
+    scheduleId = 0;
 }
 
 #if defined(ENABLE_LUA)
-Timer::Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args): ScriptFunction(callback, lua, 'v', def)
+Timer::Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, const ScriptArguments &args): ScriptFunction(callback, lua, 'v', def),
+    args(args)
 {
     targetMsec = msec;
-    this->args = args;
+    this->args.KeepStrings();
     isEnded = true;
+    scheduleId = 0;
 }
 #endif
 
-void Timer::Tick()
-{
-    if (isEnded)
-        return;
-
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-
-    if (time - startTime >= targetMsec)
-    {
-        isEnded = true;
-        Call(args);
-    }
-}
-
 bool Timer::IsEnded()
 {
     return isEnded;
@@ -46,156 +36,212 @@ void Timer::Stop()
     isEnded = true;
 }
 
-void Timer::Restart(int msec)
+void Timer::Restart(int msec, Clock::time_point now)
 {
     targetMsec = msec;
-    Start();
+    Start(now);
 }
 
-void Timer::Start()
+void Timer::Start(Clock::time_point now)
 {
     isEnded = false;
-
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-    startTime = msec;
+    deadline = now + std::chrono::milliseconds(targetMsec);
 }
 
-int TimerAPI::pointer = 0;
-std::unordered_map<int, Timer* > TimerAPI::timers;
+std::vector<Timer*> TimerAPI::timers;
+std::vector<int> TimerAPI::freeIds;
+std::vector<TimerAPI::ScheduledTimer> TimerAPI::queue;
+std::vector<TimerAPI::ScheduledTimer> TimerAPI::dueTimers;
+uint64_t TimerAPI::lastScheduleId = 0;
+size_t TimerAPI::runningTimers = 0;
 
-#if defined(ENABLE_LUA)
-int TimerAPI::CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args)
+int TimerAPI::AddTimer(Timer *timer)
 {
-    int id = -1;
-
-    for (auto timer : timers)
+    if (!freeIds.empty())
     {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(lua, callback, msec, def, args);
-        id = timer.first;
+        int id = freeIds.back();
+        freeIds.pop_back();
+        timers[id] = timer;
+        return id;
     }
 
-    if (id == -1)
+    timers.push_back(timer);
+    return (int) timers.size() - 1;
+}
+
+Timer *TimerAPI::GetTimer(int timerid)
+{
+    if (timerid < 0 || timerid >= (int) timers.size() || timers[timerid] == nullptr)
     {
-        timers[pointer] = new Timer(lua, callback, msec, def, args);
-        id = pointer;
-        pointer++;
+        std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return nullptr;
     }
 
-    return id;
+    return timers[timerid];
 }
-#endif
 
+void TimerAPI::Schedule(int timerid)
+{
+    Timer *timer = timers[timerid];
+    timer->scheduleId = ++lastScheduleId;
 
-int TimerAPI::CreateTimer(ScriptFunc callback, long msec, const std::string &def, std::vector<boost::any> args)
+    queue.push_back({timer->deadline, timerid, timer->scheduleId});
+    std::push_heap(queue.begin(), queue.end(), std::greater<ScheduledTimer>());
+
+    if (queue.size() > 2 * runningTimers + 64)
+        RemoveStaleEntries();
+}
+
+bool TimerAPI::IsCurrent(const ScheduledTimer &scheduled)
 {
-    int id = -1;
+    Timer *timer = timers[scheduled.timerid];
+    return timer != nullptr && !timer->isEnded && timer->scheduleId == scheduled.scheduleId;
+}
 
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(callback, msec, def, args);
-        id = timer.first;
-    }
+void TimerAPI::RemoveStaleEntries()
+{
+    queue.erase(std::remove_if(queue.begin(), queue.end(), [](const ScheduledTimer &scheduled) {
+        return !IsCurrent(scheduled);
+    }), queue.end());
+    std::make_heap(queue.begin(), queue.end(), std::greater<ScheduledTimer>());
+}
+
+#if defined(ENABLE_LUA)
+int TimerAPI::CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, const ScriptArguments &args)
+{
+    return AddTimer(new Timer(lua, callback, msec, def, args));
+}
+#endif
 
-    if (id == -1)
-    {
-        timers[pointer] = new Timer(callback, msec, def, args);
-        id = pointer;
-        pointer++;
-    }
 
-    return id;
+int TimerAPI::CreateTimer(ScriptFunc callback, long msec, const std::string &def, const ScriptArguments &args)
+{
+    return AddTimer(new Timer(callback, msec, def, args));
 }
 
 void TimerAPI::FreeTimer(int timerid)
 {
+    Timer *timer = GetTimer(timerid);
+    if (timer == nullptr)
+        return;
 
-    try
-    {
-        if (timers.at(timerid) != nullptr)
-        {
-            delete timers[timerid];
-            timers[timerid] = nullptr;
-        }
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    if (!timer->isEnded)
+        runningTimers--;
+
+    // Any queue entry left for the timer is skipped from now on, because its slot is either empty
+    // or taken by a timer with a different schedule ID
+    delete timer;
+    timers[timerid] = nullptr;
+    freeIds.push_back(timerid);
 }
 
 void TimerAPI::ResetTimer(int timerid, long msec)
 {
-    try
-    {
-        timers.at(timerid)->Restart(msec);
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+    if (timer == nullptr)
+        return;
+
+    if (timer->isEnded)
+        runningTimers++;
+
+    timer->Restart(msec, Timer::Clock::now());
+    Schedule(timerid);
 }
 
 void TimerAPI::StartTimer(int timerid)
 {
-    try
-    {
-        Timer *timer = timers.at(timerid);
-        if (timer == nullptr)
-            throw 1;
-        timer->Start();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+    if (timer == nullptr)
+        return;
+
+    if (timer->isEnded)
+        runningTimers++;
+
+    timer->Start(Timer::Clock::now());
+    Schedule(timerid);
 }
 
 void TimerAPI::StopTimer(int timerid)
 {
-    try
-    {
-        timers.at(timerid)->Stop();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+    if (timer == nullptr)
+        return;
+
+    if (!timer->isEnded)
+        runningTimers--;
+
+    timer->Stop();
 }
 
 bool TimerAPI::IsTimerElapsed(int timerid)
 {
-    bool ret = false;
-    try
-    {
-        ret = timers.at(timerid)->IsEnded();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
-    return ret;
+    Timer *timer = GetTimer(timerid);
+    if (timer == nullptr)
+        return false;
+
+    return timer->IsEnded();
 }
 
 void TimerAPI::Terminate()
 {
-    for (auto timer : timers)
+    for (auto &timer : timers)
     {
-        if (timer.second != nullptr)
-            delete timer.second;
-        timer.second = nullptr;
+        delete timer;
+        timer = nullptr;
     }
+
+    timers.clear();
+    freeIds.clear();
+    queue.clear();
+    runningTimers = 0;
 }
 
 void TimerAPI::Tick()
 {
-    for (auto timer : timers)
+    if (queue.empty())
+        return;
+
+    const Timer::Clock::time_point now = Timer::Clock::now();
+    dueTimers.clear();
+
+    // Take every due timer off the queue before calling any of them, so timers started from their
+    // callbacks wait for the next tick even if they are already due
+    while (!queue.empty() && queue.front().deadline <= now)
+    {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<ScheduledTimer>());
+        dueTimers.push_back(queue.back());
+        queue.pop_back();
+    }
+
+    for (const auto &scheduled : dueTimers)
+    {
+        // Earlier callbacks in this tick may have stopped, restarted or freed the timer
+        if (!IsCurrent(scheduled))
+            continue;
+
+        Timer *timer = timers[scheduled.timerid];
+        timer->isEnded = true;
+        runningTimers--;
+        timer->Call(timer->args);
+    }
+}
+
+long TimerAPI::GetTimeUntilNextTimer()
+{
+    while (!queue.empty() && !IsCurrent(queue.front()))
     {
-        if (timer.second != nullptr)
-            timer.second->Tick();
+        std::pop_heap(queue.begin(), queue.end(), std::greater<ScheduledTimer>());
+        queue.pop_back();
     }
+
+    if (queue.empty())
+        return -1;
+
+    auto remaining = queue.front().deadline - Timer::Clock::now();
+
+    if (remaining <= Timer::Clock::duration::zero())
+        return 0;
+
+    // Round up, so waiting for this long never wakes up before the timer is due
+    return (long) std::chrono::duration_cast<std::chrono::milliseconds>(remaining + std::chrono::milliseconds(1) - Timer::Clock::duration(1)).count();
 }
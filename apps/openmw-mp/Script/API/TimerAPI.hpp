@@ -1,7 +1,10 @@
 #ifndef OPENMW_TIMERAPI_HPP
 #define OPENMW_TIMERAPI_HPP
 
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <Script/Script.hpp>
 #include <Script/ScriptFunction.hpp>
@@ -16,32 +19,34 @@ namespace mwmp
         friend class TimerAPI;
 
     public:
+        typedef std::chrono::steady_clock Clock;
 
-        Timer(ScriptFunc callback, long msec, const std::string& def, std::vector<boost::any> args);
+        Timer(ScriptFunc callback, long msec, const std::string& def, const ScriptArguments &args);
 #if defined(ENABLE_LUA)
-        Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args);
+        Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, const ScriptArguments &args);
 #endif
-        void Tick();
 
         bool IsEnded();
         void Stop();
-        void Start();
-        void Restart(int msec);
+        void Start(Clock::time_point now);
+        void Restart(int msec, Clock::time_point now);
     private:
-        double startTime, targetMsec;
-        std::string publ, arg_types;
-        std::vector<boost::any> args;
-        Script *scr;
+        Clock::time_point deadline;
+        long targetMsec;
+        ScriptArguments args;
         bool isEnded;
+        // Identifies the queue entry for the timer's current run, so entries left over from
+        // earlier runs can be told apart and skipped
+        uint64_t scheduleId;
     };
 
     class TimerAPI
     {
     public:
 #if defined(ENABLE_LUA)
-        static int CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args);
+        static int CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, const ScriptArguments &args);
 #endif
-        static int CreateTimer(ScriptFunc callback, long msec, const std::string& def, std::vector<boost::any> args);
+        static int CreateTimer(ScriptFunc callback, long msec, const std::string& def, const ScriptArguments &args);
         static void FreeTimer(int timerid);
         static void ResetTimer(int timerid, long msec);
         static void StartTimer(int timerid);
@@ -51,9 +56,40 @@ namespace mwmp
         static void Terminate();
 
         static void Tick();
+
+        // Milliseconds until the earliest running timer ends, or -1 if no timer is running
+        static long GetTimeUntilNextTimer();
     private:
-        static std::unordered_map<int, Timer* > timers;
-        static int pointer;
+        struct ScheduledTimer
+        {
+            Timer::Clock::time_point deadline;
+            int timerid;
+            uint64_t scheduleId;
+
+            bool operator>(const ScheduledTimer &other) const
+            {
+                return deadline > other.deadline;
+            }
+        };
+
+        static int AddTimer(Timer *timer);
+        static Timer *GetTimer(int timerid);
+        static void Schedule(int timerid);
+        static bool IsCurrent(const ScheduledTimer &scheduled);
+        static void RemoveStaleEntries();
+
+        // Indexed by timer ID, with freed IDs kept in freeIds for reuse
+        static std::vector<Timer*> timers;
+        static std::vector<int> freeIds;
+
+        // Min-heap of running timers ordered by deadline
+        //
+        // Stopping or restarting a timer leaves its old entry in place, which is skipped once it
+        // reaches the top and cleared out in bulk if too many of them pile up
+        static std::vector<ScheduledTimer> queue;
+        static std::vector<ScheduledTimer> dueTimers;
+        static uint64_t lastScheduleId;
+        static size_t runningTimers;
     };
 }
 
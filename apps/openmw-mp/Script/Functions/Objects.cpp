@@ -2,6 +2,7 @@
 #include <components/openmw-mp/Base/BaseObject.hpp>
 
 #include <apps/openmw-mp/Networking.hpp>
+#include <apps/openmw-mp/InterestManager.hpp>
 #include <apps/openmw-mp/Player.hpp>
 #include <apps/openmw-mp/Utils.hpp>
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
@@ -27,6 +28,7 @@ void ObjectFunctions::ReadReceivedObjectList() noexcept
 void ObjectFunctions::ClearObjectList() noexcept
 {
     writeObjectList.cell.blank();
+    writeObjectList.hasCell = false;
     writeObjectList.baseObjects.clear();
     writeObjectList.packetOrigin = mwmp::PACKET_ORIGIN::SERVER_SCRIPT;
 }
@@ -42,6 +44,7 @@ void ObjectFunctions::SetObjectListPid(unsigned short pid) noexcept
 void ObjectFunctions::CopyReceivedObjectListToStore() noexcept
 {
     writeObjectList = *readObjectList;
+    writeObjectList.hasCell = true;
 }
 
 unsigned int ObjectFunctions::GetObjectListSize() noexcept
@@ -433,6 +436,7 @@ bool ObjectFunctions::IsObjectDroppedByPlayer(unsigned int index) noexcept
 void ObjectFunctions::SetObjectListCell(const char* cellDescription) noexcept
 {
     writeObjectList.cell = Utils::getCellFromDescription(cellDescription);
+    writeObjectList.hasCell = true;
 }
 
 void ObjectFunctions::SetObjectListAction(unsigned char action) noexcept
@@ -720,7 +724,7 @@ void ObjectFunctions::SendObjectActivate(bool sendToOtherPlayers, bool skipAttac
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectPlace(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -731,7 +735,7 @@ void ObjectFunctions::SendObjectPlace(bool sendToOtherPlayers, bool skipAttached
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectSpawn(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -742,7 +746,7 @@ void ObjectFunctions::SendObjectSpawn(bool sendToOtherPlayers, bool skipAttached
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectDelete(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -753,7 +757,7 @@ void ObjectFunctions::SendObjectDelete(bool sendToOtherPlayers, bool skipAttache
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectLock(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -764,7 +768,7 @@ void ObjectFunctions::SendObjectLock(bool sendToOtherPlayers, bool skipAttachedP
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectDialogueChoice(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -775,7 +779,7 @@ void ObjectFunctions::SendObjectDialogueChoice(bool sendToOtherPlayers, bool ski
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectMiscellaneous(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -786,7 +790,7 @@ void ObjectFunctions::SendObjectMiscellaneous(bool sendToOtherPlayers, bool skip
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectRestock(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -797,7 +801,7 @@ void ObjectFunctions::SendObjectRestock(bool sendToOtherPlayers, bool skipAttach
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectTrap(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -808,7 +812,7 @@ void ObjectFunctions::SendObjectTrap(bool sendToOtherPlayers, bool skipAttachedP
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectScale(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -819,7 +823,7 @@ void ObjectFunctions::SendObjectScale(bool sendToOtherPlayers, bool skipAttached
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectSound(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -830,7 +834,7 @@ void ObjectFunctions::SendObjectSound(bool sendToOtherPlayers, bool skipAttached
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectState(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -841,7 +845,7 @@ void ObjectFunctions::SendObjectState(bool sendToOtherPlayers, bool skipAttached
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectMove(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -852,7 +856,7 @@ void ObjectFunctions::SendObjectMove(bool sendToOtherPlayers, bool skipAttachedP
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendObjectRotate(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -863,7 +867,7 @@ void ObjectFunctions::SendObjectRotate(bool sendToOtherPlayers, bool skipAttache
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendDoorState(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -874,7 +878,7 @@ void ObjectFunctions::SendDoorState(bool sendToOtherPlayers, bool skipAttachedPl
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendDoorDestination(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -885,7 +889,7 @@ void ObjectFunctions::SendDoorDestination(bool sendToOtherPlayers, bool skipAtta
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -896,7 +900,7 @@ void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPl
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendVideoPlay(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -907,7 +911,7 @@ void ObjectFunctions::SendVideoPlay(bool sendToOtherPlayers, bool skipAttachedPl
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendClientScriptLocal(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -918,7 +922,7 @@ void ObjectFunctions::SendClientScriptLocal(bool sendToOtherPlayers, bool skipAt
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 void ObjectFunctions::SendConsoleCommand(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -929,7 +933,7 @@ void ObjectFunctions::SendConsoleCommand(bool sendToOtherPlayers, bool skipAttac
     if (!skipAttachedPlayer)
         packet->Send(false);
     if (sendToOtherPlayers)
-        packet->Send(true);
+        InterestManager::get()->sendToInterested(packet, writeObjectList.hasCell ? &writeObjectList.cell : nullptr);
 }
 
 
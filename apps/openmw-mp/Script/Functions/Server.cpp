@@ -7,7 +7,9 @@
 
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
 #include <apps/openmw-mp/Networking.hpp>
+#include <apps/openmw-mp/InterestManager.hpp>
 #include <apps/openmw-mp/MasterClient.hpp>
+#include <apps/openmw-mp/Profiler.hpp>
 #include <Script/Script.hpp>
 
 static std::string tempFilename;
@@ -145,6 +147,82 @@ bool ServerFunctions::GetScriptErrorIgnoringState() noexcept
     return mwmp::Networking::getPtr()->getScriptErrorIgnoringState();
 }
 
+int ServerFunctions::GetInterestRadius() noexcept
+{
+    return InterestManager::get()->getRadius();
+}
+
+double ServerFunctions::GetLoopIterationCount() noexcept
+{
+    return (double) mwmp::Networking::getPtr()->getLoopStats().iterations;
+}
+
+double ServerFunctions::GetLoopPacketCount() noexcept
+{
+    return (double) mwmp::Networking::getPtr()->getLoopStats().packets;
+}
+
+unsigned int ServerFunctions::GetLoopMaxPacketsPerIteration() noexcept
+{
+    return mwmp::Networking::getPtr()->getLoopStats().maxPacketsPerIteration;
+}
+
+double ServerFunctions::GetLoopPacketTime() noexcept
+{
+    return mwmp::Networking::getPtr()->getLoopStats().packetTime;
+}
+
+double ServerFunctions::GetLoopTimerTime() noexcept
+{
+    return mwmp::Networking::getPtr()->getLoopStats().timerTime;
+}
+
+double ServerFunctions::GetLoopWaitTime() noexcept
+{
+    return mwmp::Networking::getPtr()->getLoopStats().waitTime;
+}
+
+void ServerFunctions::ResetLoopStats() noexcept
+{
+    mwmp::Networking::getPtr()->resetLoopStats();
+}
+
+bool ServerFunctions::GetProfilerState() noexcept
+{
+    return Profiler::isEnabled();
+}
+
+const char *ServerFunctions::GetProfilerReport() noexcept
+{
+    static std::string report;
+    report = Profiler::getReport();
+    return report.c_str();
+}
+
+double ServerFunctions::GetProfilerPacketRate(unsigned short pid) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, 0);
+
+    const Profiler::PlayerStats *stats = Profiler::getPlayerStats(player->guid);
+    double elapsed = Profiler::getElapsedTime();
+
+    if (stats == nullptr || elapsed <= 0)
+        return 0;
+
+    return stats->received / elapsed;
+}
+
+void ServerFunctions::SetProfilerState(bool state) noexcept
+{
+    Profiler::setEnabled(state);
+}
+
+void ServerFunctions::ResetProfilerStats() noexcept
+{
+    Profiler::reset();
+}
+
 void ServerFunctions::SetGameMode(const char *gameMode) noexcept
 {
     if (mwmp::Networking::getPtr()->getMasterClient())
@@ -172,6 +250,11 @@ void ServerFunctions::SetScriptErrorIgnoringState(bool state) noexcept
     mwmp::Networking::getPtr()->setScriptErrorIgnoringState(state);
 }
 
+void ServerFunctions::SetInterestRadius(int radius) noexcept
+{
+    InterestManager::get()->setRadius(radius);
+}
+
 void ServerFunctions::SetRuleString(const char *key, const char *value) noexcept
 {
     auto mc = mwmp::Networking::getPtr()->getMasterClient();
@@ -28,12 +28,27 @@
     {"HasPassword",                     ServerFunctions::HasPassword},\
     {"GetDataFileEnforcementState",     ServerFunctions::GetDataFileEnforcementState},\
     {"GetScriptErrorIgnoringState",     ServerFunctions::GetScriptErrorIgnoringState},\
+    {"GetInterestRadius",               ServerFunctions::GetInterestRadius},\
+    {"GetLoopIterationCount",           ServerFunctions::GetLoopIterationCount},\
+    {"GetLoopPacketCount",              ServerFunctions::GetLoopPacketCount},\
+    {"GetLoopMaxPacketsPerIteration",   ServerFunctions::GetLoopMaxPacketsPerIteration},\
+    {"GetLoopPacketTime",               ServerFunctions::GetLoopPacketTime},\
+    {"GetLoopTimerTime",                ServerFunctions::GetLoopTimerTime},\
+    {"GetLoopWaitTime",                 ServerFunctions::GetLoopWaitTime},\
+    {"ResetLoopStats",                  ServerFunctions::ResetLoopStats},\
+    \
+    {"GetProfilerState",                ServerFunctions::GetProfilerState},\
+    {"GetProfilerReport",               ServerFunctions::GetProfilerReport},\
+    {"GetProfilerPacketRate",           ServerFunctions::GetProfilerPacketRate},\
+    {"SetProfilerState",                ServerFunctions::SetProfilerState},\
+    {"ResetProfilerStats",              ServerFunctions::ResetProfilerStats},\
     \
     {"SetGameMode",                     ServerFunctions::SetGameMode},\
     {"SetHostname",                     ServerFunctions::SetHostname},\
     {"SetServerPassword",               ServerFunctions::SetServerPassword},\
     {"SetDataFileEnforcementState",     ServerFunctions::SetDataFileEnforcementState},\
     {"SetScriptErrorIgnoringState",     ServerFunctions::SetScriptErrorIgnoringState},\
+    {"SetInterestRadius",               ServerFunctions::SetInterestRadius},\
     {"SetRuleString",                   ServerFunctions::SetRuleString},\
     {"SetRuleValue",                    ServerFunctions::SetRuleValue},\
     \
@@ -227,6 +242,116 @@ public:
     */
     static bool GetScriptErrorIgnoringState() noexcept;
 
+    /**
+    * \brief Get the interest radius of the server.
+    *
+    * Packets about a cell or player that are sent to other players only reach players
+    * who have a cell loaded within this many exterior cells of it, or the same interior.
+    *
+    * \return The interest radius, or -1 if packets are sent to every player.
+    */
+    static int GetInterestRadius() noexcept;
+
+    /**
+    * \brief Get the number of iterations of the server's main loop since its loop statistics
+    *        were last reset.
+    *
+    * \return The number of iterations, as a double so it doesn't overflow an unsigned int on
+    *         long-running servers.
+    */
+    static double GetLoopIterationCount() noexcept;
+
+    /**
+    * \brief Get the number of packets handled by the server's main loop since its loop statistics
+    *        were last reset.
+    *
+    * \return The number of packets, as a double so it doesn't overflow an unsigned int on
+    *         long-running servers.
+    */
+    static double GetLoopPacketCount() noexcept;
+
+    /**
+    * \brief Get the largest number of packets handled in a single iteration of the server's main
+    *        loop since its loop statistics were last reset.
+    *
+    * \return The number of packets.
+    */
+    static unsigned int GetLoopMaxPacketsPerIteration() noexcept;
+
+    /**
+    * \brief Get the time spent handling packets since the loop statistics were last reset,
+    *        including the time spent in the script callbacks they trigger.
+    *
+    * \return The time in milliseconds.
+    */
+    static double GetLoopPacketTime() noexcept;
+
+    /**
+    * \brief Get the time spent running script timers since the loop statistics were last reset.
+    *
+    * \return The time in milliseconds.
+    */
+    static double GetLoopTimerTime() noexcept;
+
+    /**
+    * \brief Get the time spent waiting for packets and timers since the loop statistics were
+    *        last reset.
+    *
+    * \return The time in milliseconds.
+    */
+    static double GetLoopWaitTime() noexcept;
+
+    /**
+    * \brief Reset the statistics of the server's main loop.
+    *
+    * \return void
+    */
+    static void ResetLoopStats() noexcept;
+
+    /**
+    * \brief Check whether the profiler is recording script callbacks, packets and player traffic.
+    *
+    * \return The profiler state.
+    */
+    static bool GetProfilerState() noexcept;
+
+    /**
+    * \brief Get everything the profiler has recorded since it was last enabled or reset, as JSON.
+    *
+    * The report has the number of seconds recorded, the calls, total and maximum milliseconds of
+    * every script callback, the packets received, handled and sent and the bytes they took for
+    * every packet type, and the packets received and sent by every player.
+    *
+    * \return The report.
+    */
+    static const char *GetProfilerReport() noexcept;
+
+    /**
+    * \brief Get the average number of packets per second received from a certain player since
+    *        the profiler was last enabled or reset.
+    *
+    * \param pid The player ID.
+    * \return The packet rate, or 0 if the profiler is disabled.
+    */
+    static double GetProfilerPacketRate(unsigned short pid) noexcept;
+
+    /**
+    * \brief Enable or disable the profiler.
+    *
+    * Enabling it resets what it has recorded. It has almost no cost while disabled.
+    *
+    * \param state The new profiler state.
+    * \return void
+    */
+    static void SetProfilerState(bool state) noexcept;
+
+    /**
+    * \brief Reset what the profiler has recorded.
+    *
+    * \return void
+    */
+    static void ResetProfilerStats() noexcept;
+
     /**
     * \brief Set the game mode of the server, as displayed in the server browser.
     *
@@ -273,6 +398,17 @@ public:
     */
     static void SetScriptErrorIgnoringState(bool state) noexcept;
 
+    /**
+    * \brief Set the interest radius of the server.
+    *
+    * Packets about a cell or player that are sent to other players only reach players
+    * who have a cell loaded within this many exterior cells of it, or the same interior.
+    *
+    * \param radius The new interest radius, or -1 to send such packets to every player.
+    * \return void
+    */
+    static void SetInterestRadius(int radius) noexcept;
+
     /**
     * \brief Set a rule string for the server details displayed in the server browser.
     *
@@ -8,15 +8,15 @@ using namespace mwmp;
 
 int ScriptFunctions::CreateTimer(ScriptFunc callback, int msec) noexcept
 {
-    return mwmp::TimerAPI::CreateTimer(callback, msec, "", std::vector<boost::any>());
+    return mwmp::TimerAPI::CreateTimer(callback, msec, "", ScriptArguments());
 }
 
 int ScriptFunctions::CreateTimerEx(ScriptFunc callback, int msec, const char *types, va_list args) noexcept
 {
     try
     {
-        std::vector<boost::any> params;
-        Utils::getArguments(params, args, types);
+        ScriptArguments params;
+        params.ReadVaList(args, types);
 
         return mwmp::TimerAPI::CreateTimer(callback, msec, types, params);
     }
@@ -182,6 +182,13 @@ void LangLua::LoadProgram(const char *filename)
     for (unsigned i = 0; i < functions_n; i++)
         tes3mp.addCFunction(functions_[i].name, functions_[i].func);
 
+    tes3mp.addCFunction("GetObjectListTable", LangLua::GetObjectListTable);
+    tes3mp.addCFunction("AddObjectsFromTable", LangLua::AddObjectsFromTable);
+    tes3mp.addCFunction("GetInventoryChangesTable", LangLua::GetInventoryChangesTable);
+    tes3mp.addCFunction("AddItemChangesFromTable", LangLua::AddItemChangesFromTable);
+    tes3mp.addCFunction("GetActorListTable", LangLua::GetActorListTable);
+    tes3mp.addCFunction("AddActorsFromTable", LangLua::AddActorsFromTable);
+
     tes3mp.endNamespace();
 
     if ((err = lua_pcall(lua, 0, 0, 0)) != 0) // Run once script for load in memory.
@@ -200,110 +207,17 @@ bool LangLua::IsCallbackPresent(const char *name)
     return luabridge::getGlobal(lua, name).isFunction();
 }
 
-boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
+int LangLua::ResolveCallback(const char *name)
 {
-    va_list vargs;
-    va_start(vargs, buf);
-
-    int n_args = (int)(strlen(argl));
-
-    lua_getglobal(lua, name);
-
-    for (int index = 0; index < n_args; index++)
-    {
-        switch (argl[index])
-        {
-            case 'i':
-                luabridge::Stack<unsigned int>::push(lua,va_arg(vargs, unsigned int));
-                break;
-
-            case 'q':
-                luabridge::Stack<signed int>::push(lua,va_arg(vargs, signed int));
-                break;
-
-            case 'l':
-                luabridge::Stack<unsigned long long>::push(lua, va_arg(vargs, unsigned long long));
-                break;
-
-            case 'w':
-                luabridge::Stack<signed long long>::push(lua, va_arg(vargs, signed long long));
-                break;
-
-            case 'f':
-                luabridge::Stack<double>::push(lua, va_arg(vargs, double));
-                break;
-
-            case 'p':
-                luabridge::Stack<void*>::push(lua, va_arg(vargs, void*));
-                break;
-
-            case 's':
-                luabridge::Stack<const char*>::push(lua, va_arg(vargs, const char*));
-                break;
-
-            case 'b':
-                luabridge::Stack<bool>::push(lua, (bool) va_arg(vargs, int));
-                break;
-
-            default:
-                throw std::runtime_error("C++ call: Unknown argument identifier " + argl[index]);
-        }
-    }
-
-    va_end(vargs);
-
-    luabridge::LuaException::pcall(lua, n_args, 1);
-    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
-}
-
-boost::any LangLua::Call(const char *name, const char *argl, const std::vector<boost::any> &args)
-{
-    int n_args = (int)(strlen(argl));
-
     lua_getglobal(lua, name);
 
-    for (int index = 0; index < n_args; index++)
+    if (!lua_isfunction(lua, -1))
     {
-        switch (argl[index])
-        {
-            case 'i':
-                luabridge::Stack<unsigned int>::push(lua, boost::any_cast<unsigned int>(args.at(index)));
-                break;
-
-            case 'q':
-                luabridge::Stack<signed int>::push(lua, boost::any_cast<signed int>(args.at(index)));
-                break;
-
-            case 'l':
-                luabridge::Stack<unsigned long long>::push(lua, boost::any_cast<unsigned long long>(args.at(index)));
-                break;
-
-            case 'w':
-                luabridge::Stack<signed long long>::push(lua, boost::any_cast<signed long long>(args.at(index)));
-                break;
-
-            case 'f':
-                luabridge::Stack<double>::push(lua, boost::any_cast<double>(args.at(index)));
-                break;
-
-            case 'p':
-                luabridge::Stack<void *>::push(lua, boost::any_cast<void *>(args.at(index)));
-                break;
-
-            case 's':
-                luabridge::Stack<const char *>::push(lua, boost::any_cast<const char *>(args.at(index)));
-                break;
-
-            case 'b':
-                luabridge::Stack<bool>::push(lua, boost::any_cast<int>(args.at(index)));
-                break;
-            default:
-                throw std::runtime_error("Lua call: Unknown argument identifier " + argl[index]);
-        }
+        lua_pop(lua, 1);
+        return LUA_NOREF;
     }
 
-    luabridge::LuaException::pcall(lua, n_args, 1);
-    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
+    return luaL_ref(lua, LUA_REGISTRYINDEX);
 }
 
 void LangLua::AddPackagePath(const std::string& path)
@@ -36,12 +36,57 @@ public:
     static int CreateTimer(lua_State *lua) noexcept;
     static int CreateTimerEx(lua_State *lua);
 
+    /*
+        Lua-only counterparts of the per-field object, inventory and actor functions, which move a whole list
+        across in a single call
+
+        Each entry is a table keyed by the field names of those functions, such as refId, refNum, count,
+        posX or healthCurrent, with object entries holding their container items in containerItems. The
+        Add functions leave out entries that are not tables and use the same defaults as the per-field
+        setters for missing fields.
+    */
+    static int GetObjectListTable(lua_State *lua);
+    static int AddObjectsFromTable(lua_State *lua);
+    static int GetInventoryChangesTable(lua_State *lua);
+    static int AddItemChangesFromTable(lua_State *lua);
+    static int GetActorListTable(lua_State *lua);
+    static int AddActorsFromTable(lua_State *lua);
+
     virtual void LoadProgram(const char *filename) override;
     virtual int FreeProgram() override;
     virtual bool IsCallbackPresent(const char *name) override;
-    virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
-    virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+
+    // Keep the global function with this name in the registry, returning LUA_NOREF if there is none
+    int ResolveCallback(const char *name);
+
+    // Call a function kept by ResolveCallback(), pushing each argument as the Lua type of its type character
+    template<typename... Args>
+    void CallCallback(int ref, Args&&... args)
+    {
+        lua_rawgeti(lua, LUA_REGISTRYINDEX, ref);
+
+        int pushed[] = {0, (PushArgument(std::forward<Args>(args)), 0)...};
+        (void) pushed;
+
+        int err = lua_pcall(lua, sizeof...(Args), 0, 0);
+
+        if (err != 0)
+        {
+            luabridge::LuaException exception(lua, err);
+            lua_pop(lua, 1);
+            throw exception;
+        }
+    }
+
 private:
+    template<typename T>
+    void PushArgument(T &&arg)
+    {
+        typedef typename std::decay<T>::type Type;
+        typedef typename CharType<TypeChar<Type, sizeof(Type)>::value>::type LuaType;
+        luabridge::Stack<LuaType>::push(lua, static_cast<LuaType>(arg));
+    }
+
     static std::set<std::string> packageCPath;
     static std::set<std::string> packagePath;
 };
@@ -3,59 +3,58 @@
 #include <Script/API/TimerAPI.hpp>
 #include <Script/API/PublicFnAPI.hpp>
 
-inline std::vector<boost::any> DefToVec(lua_State *lua, std::string types, int args_begin, int args_n)
+inline void DefToArgs(lua_State *lua, const std::string &types, int args_begin, int args_n, ScriptArguments &args)
 {
-    std::vector<boost::any> args;
-
     for (int i = args_begin; i < args_n + args_begin; i++)
     {
-        switch (types[i - args_begin])
+        const char type = types[i - args_begin];
+
+        switch (type)
         {
             case 'i':
             {
-                args.emplace_back(luabridge::Stack<unsigned int>::get(lua, i));
+                args.Add(type).i = luabridge::Stack<unsigned int>::get(lua, i);
                 break;
             }
 
             case 'q':
             {
-                args.emplace_back(luabridge::Stack<signed int>::get(lua, i));
+                args.Add(type).q = luabridge::Stack<signed int>::get(lua, i);
                 break;
             }
 
                 /*case 'l':
                 {
-                    args.emplace_back(luabridge::Stack<unsigned long long>::get(lua, i));
+                    args.Add(type).l = luabridge::Stack<unsigned long long>::get(lua, i);
                     break;
                 }
 
                 case 'w':
                 {
-                    args.emplace_back(luabridge::Stack<signed long long>::get(lua, i));
+                    args.Add(type).w = luabridge::Stack<signed long long>::get(lua, i);
                     break;
                 }*/
 
             case 'f':
             {
-                args.emplace_back(luabridge::Stack<double>::get(lua, i));
+                args.Add(type).f = luabridge::Stack<double>::get(lua, i);
                 break;
             }
 
             case 's':
             {
-                args.emplace_back(luabridge::Stack<const char*>::get(lua, i));
+                args.Add(type).s = luabridge::Stack<const char*>::get(lua, i);
                 break;
             }
 
             default:
             {
                 std::stringstream ssErr;
-                ssErr << "Lua: Unknown argument identifier" << "\"" << types[i] << "\"" << std::endl;
+                ssErr << "Lua: Unknown argument identifier" << "\"" << type << "\"" << std::endl;
                 throw std::runtime_error(ssErr.str());
             }
         }
     }
-    return args;
 }
 
 int LangLua::MakePublic(lua_State *lua) noexcept
@@ -65,36 +64,58 @@ int LangLua::MakePublic(lua_State *lua) noexcept
     char ret_type = luabridge::Stack<char>::get(lua, 3);
     const char * def = luabridge::Stack<const char*>::get(lua, 4);
 
-    Public::MakePublic(callback, lua, name, ret_type, def);
-    return 0;
+    int handle = Public::MakePublic(callback, lua, name, ret_type, def);
+    luabridge::push(lua, handle);
+    return 1;
 
 }
 
 int LangLua::CallPublic(lua_State *lua)
 {
-    const char * name = luabridge::Stack<const char*>::get(lua, 1);
+    // Publics can be called through the handle returned by MakePublic, which skips looking up their name
+    int handle;
+
+    if (lua_type(lua, 1) == LUA_TNUMBER)
+        handle = luabridge::Stack<int>::get(lua, 1);
+    else
+    {
+        const char * name = luabridge::Stack<const char*>::get(lua, 1);
+        handle = Public::GetHandle(name);
+
+        if (handle == -1)
+            throw std::runtime_error("Public with name \"" + std::string(name) + "\" does not exist");
+    }
 
     int args_n = lua_gettop(lua) - 1;
 
-    std::string types = Public::GetDefinition(name);
+    const std::string &types = Public::GetDefinition(handle);
 
     if (args_n  != (long)types.size())
         throw std::invalid_argument("Script call: Number of arguments does not match definition");
 
-    std::vector<boost::any> args = DefToVec(lua, types, 2, args_n);
+    ScriptArguments args;
+    DefToArgs(lua, types, 2, args_n, args);
 
-    boost::any result = Public::Call(&name[0], args);
-    if (result.empty())
-        return 0;
+    ScriptArgument result = Public::Call(handle, args);
+
+    switch (result.type)
+    {
+        case 'q':
+            luabridge::Stack<signed int>::push(lua, result.q);
+            break;
+        case 'i':
+            luabridge::Stack<unsigned int>::push(lua, result.i);
+            break;
+        case 'f':
+            luabridge::Stack<double>::push(lua, result.f);
+            break;
+        case 's':
+            luabridge::Stack<const char*>::push(lua, result.s);
+            break;
+        default:
+            return 0;
+    }
 
-    if (result.type().hash_code() == typeid(signed int).hash_code())
-        luabridge::Stack<signed int>::push(lua, boost::any_cast<signed int>(result));
-    else if (result.type().hash_code() == typeid(unsigned int).hash_code())
-        luabridge::Stack<unsigned int>::push(lua, boost::any_cast<unsigned int>(result));
-    else if (result.type().hash_code() == typeid(double).hash_code())
-        luabridge::Stack<double>::push(lua, boost::any_cast<double>(result));
-    else if (result.type().hash_code() == typeid(const char*).hash_code())
-        luabridge::Stack<const char*>::push(lua, boost::any_cast<const char*>(result));
     return 1;
 }
 
@@ -104,7 +125,7 @@ int LangLua::CreateTimer(lua_State *lua) noexcept
     const char * callback= luabridge::Stack<const char*>::get(lua, 1);
     int msec = luabridge::Stack<int>::get(lua, 2);
 
-    int id = mwmp::TimerAPI::CreateTimerLua(lua, callback, msec, "", std::vector<boost::any>());
+    int id = mwmp::TimerAPI::CreateTimerLua(lua, callback, msec, "", ScriptArguments());
     luabridge::push(lua, id);
     return 1;
 }
@@ -118,57 +139,8 @@ int LangLua::CreateTimerEx(lua_State *lua)
 
     int args_n = (int)lua_strlen(lua, 3);
 
-    std::vector<boost::any> args;
-
-    for (int i = 4; i < args_n + 4; i++)
-    {
-        switch (types[i - 4])
-        {
-            case 'i':
-            {
-                args.emplace_back(luabridge::Stack<unsigned int>::get(lua, i));
-                break;
-            }
-
-            case 'q':
-            {
-                args.emplace_back(luabridge::Stack<signed int>::get(lua, i));
-                break;
-            }
-
-                /*case 'l':
-                {
-                    args.emplace_back(luabridge::Stack<unsigned long long>::get(lua, i));
-                    break;
-                }
-
-                case 'w':
-                {
-                    args.emplace_back(luabridge::Stack<signed long long>::get(lua, i));
-                    break;
-                }*/
-
-            case 'f':
-            {
-                args.emplace_back(luabridge::Stack<double>::get(lua, i));
-                break;
-            }
-
-            case 's':
-            {
-                args.emplace_back(luabridge::Stack<const char*>::get(lua, i));
-                break;
-            }
-
-            default:
-            {
-                std::stringstream ssErr;
-                ssErr << "Lua: Unknown argument identifier" << "\"" << types[i] << "\"" << std::endl;
-                throw std::runtime_error(ssErr.str());
-            }
-        }
-    }
-
+    ScriptArguments args;
+    DefToArgs(lua, types, 4, args_n, args);
 
     int id = mwmp::TimerAPI::CreateTimerLua(lua, callback, msec, types, args);
     luabridge::push(lua, id);
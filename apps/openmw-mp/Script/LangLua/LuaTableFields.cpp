@@ -0,0 +1,151 @@
+#include "LuaTableFields.hpp"
+
+void LuaTableFields::setPosition(lua_State *lua, const ESM::Position &position)
+{
+    setNumber(lua, "posX", position.pos[0]);
+    setNumber(lua, "posY", position.pos[1]);
+    setNumber(lua, "posZ", position.pos[2]);
+    setNumber(lua, "rotX", position.rot[0]);
+    setNumber(lua, "rotY", position.rot[1]);
+    setNumber(lua, "rotZ", position.rot[2]);
+}
+
+void LuaTableFields::getPosition(lua_State *lua, ESM::Position &position)
+{
+    position.pos[0] = (float) getNumber(lua, "posX", position.pos[0]);
+    position.pos[1] = (float) getNumber(lua, "posY", position.pos[1]);
+    position.pos[2] = (float) getNumber(lua, "posZ", position.pos[2]);
+    position.rot[0] = (float) getNumber(lua, "rotX", position.rot[0]);
+    position.rot[1] = (float) getNumber(lua, "rotY", position.rot[1]);
+    position.rot[2] = (float) getNumber(lua, "rotZ", position.rot[2]);
+}
+
+void LuaTableFields::pushItem(lua_State *lua, const std::string &refId, int count, int charge,
+    double enchantmentCharge, const std::string &soul)
+{
+    lua_createtable(lua, 0, 6);
+    setString(lua, "refId", refId);
+    setNumber(lua, "count", count);
+    setNumber(lua, "charge", charge);
+    setNumber(lua, "enchantmentCharge", enchantmentCharge);
+    setString(lua, "soul", soul);
+}
+
+void LuaTableFields::pushObject(lua_State *lua, const mwmp::BaseObject &object)
+{
+    lua_createtable(lua, 0, 36);
+    setString(lua, "refId", object.refId);
+    setNumber(lua, "refNum", object.refNum);
+    setNumber(lua, "mpNum", object.mpNum);
+    setNumber(lua, "count", object.count);
+    setNumber(lua, "charge", object.charge);
+    setNumber(lua, "enchantmentCharge", object.enchantmentCharge);
+    setString(lua, "soul", object.soul);
+    setNumber(lua, "goldValue", object.goldValue);
+    setNumber(lua, "scale", object.scale);
+    setBool(lua, "state", object.objectState);
+    setNumber(lua, "doorState", object.doorState);
+    setNumber(lua, "lockLevel", object.lockLevel);
+    setBool(lua, "droppedByPlayer", object.droppedByPlayer);
+    setPosition(lua, object.position);
+
+    setNumber(lua, "dialogueChoiceType", object.dialogueChoiceType);
+    setString(lua, "dialogueChoiceTopic", object.topicId);
+    setNumber(lua, "goldPool", object.goldPool);
+    setNumber(lua, "lastGoldRestockHour", object.lastGoldRestockHour);
+    setNumber(lua, "lastGoldRestockDay", object.lastGoldRestockDay);
+
+    setBool(lua, "summonState", object.isSummon);
+    setNumber(lua, "summonEffectId", object.summonEffectId);
+    setString(lua, "summonSpellId", object.summonSpellId);
+    setNumber(lua, "summonDuration", object.summonDuration);
+    setString(lua, "summonerRefId", object.master.refId);
+    setNumber(lua, "summonerRefNum", object.master.refNum);
+    setNumber(lua, "summonerMpNum", object.master.mpNum);
+
+    // Only container packets fill in container items
+    if (!object.containerItems.empty())
+    {
+        const size_t itemCount = object.containerItems.size();
+
+        lua_createtable(lua, (int) itemCount, 0);
+
+        for (size_t i = 0; i < itemCount; i++)
+        {
+            const mwmp::ContainerItem &item = object.containerItems[i];
+
+            pushItem(lua, item.refId, item.count, item.charge, item.enchantmentCharge, item.soul);
+            setNumber(lua, "actionCount", item.actionCount);
+            lua_rawseti(lua, -2, (int) i + 1);
+        }
+
+        lua_setfield(lua, -2, "containerItems");
+    }
+}
+
+void LuaTableFields::readObject(lua_State *lua, mwmp::BaseObject &object)
+{
+    object.refId = getString(lua, "refId", "");
+    object.refNum = (unsigned int) getNumber(lua, "refNum", 0);
+    object.mpNum = (unsigned int) getNumber(lua, "mpNum", 0);
+    object.count = (int) getNumber(lua, "count", 0);
+    object.charge = (int) getNumber(lua, "charge", 0);
+    object.enchantmentCharge = getNumber(lua, "enchantmentCharge", 0);
+    object.soul = getString(lua, "soul", "");
+    object.goldValue = (int) getNumber(lua, "goldValue", 0);
+    object.scale = (float) getNumber(lua, "scale", 0);
+    object.objectState = getBool(lua, "state", false);
+    object.doorState = (int) getNumber(lua, "doorState", 0);
+    object.lockLevel = (int) getNumber(lua, "lockLevel", 0);
+    object.droppedByPlayer = getBool(lua, "droppedByPlayer", false);
+    getPosition(lua, object.position);
+
+    object.dialogueChoiceType = (unsigned char) getNumber(lua, "dialogueChoiceType", 0);
+    object.topicId = getString(lua, "dialogueChoiceTopic", "");
+    object.goldPool = (unsigned int) getNumber(lua, "goldPool", 0);
+    object.lastGoldRestockHour = (float) getNumber(lua, "lastGoldRestockHour", 0);
+    object.lastGoldRestockDay = (int) getNumber(lua, "lastGoldRestockDay", 0);
+
+    object.isSummon = getBool(lua, "summonState", false);
+    object.summonEffectId = (int) getNumber(lua, "summonEffectId", 0);
+    object.summonSpellId = getString(lua, "summonSpellId", "");
+    object.summonDuration = (float) getNumber(lua, "summonDuration", 0);
+    object.master.isPlayer = false;
+    object.master.refId = getString(lua, "summonerRefId", "");
+    object.master.refNum = (unsigned int) getNumber(lua, "summonerRefNum", 0);
+    object.master.mpNum = (unsigned int) getNumber(lua, "summonerMpNum", 0);
+
+    object.containerItems.clear();
+
+    lua_getfield(lua, -1, "containerItems");
+
+    if (lua_istable(lua, -1))
+    {
+        const size_t itemCount = lua_objlen(lua, -1);
+        object.containerItems.reserve(itemCount);
+
+        for (size_t i = 1; i <= itemCount; i++)
+        {
+            lua_rawgeti(lua, -1, (int) i);
+
+            if (lua_istable(lua, -1))
+            {
+                mwmp::ContainerItem item = {};
+                item.refId = getString(lua, "refId", "");
+                item.count = (int) getNumber(lua, "count", 0);
+                item.charge = (int) getNumber(lua, "charge", 0);
+                item.enchantmentCharge = getNumber(lua, "enchantmentCharge", 0);
+                item.soul = getString(lua, "soul", "");
+                item.actionCount = (int) getNumber(lua, "actionCount", 0);
+
+                object.containerItems.push_back(item);
+            }
+
+            lua_pop(lua, 1);
+        }
+    }
+
+    lua_pop(lua, 1);
+
+    object.containerItemCount = (unsigned int) object.containerItems.size();
+}
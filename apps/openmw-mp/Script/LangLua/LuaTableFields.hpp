@@ -0,0 +1,87 @@
+#ifndef OPENMW_LUATABLEFIELDS_HPP
+#define OPENMW_LUATABLEFIELDS_HPP
+
+#include "lua.hpp"
+
+#include <string>
+
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+/*
+    Conversions between list entries and the Lua tables of the table-based list functions, kept apart from
+    anything that needs the server's state so they can be tested on their own
+*/
+namespace LuaTableFields
+{
+    // Setters for the fields of the table on top of the stack
+
+    inline void setNumber(lua_State *lua, const char *key, lua_Number value)
+    {
+        lua_pushnumber(lua, value);
+        lua_setfield(lua, -2, key);
+    }
+
+    inline void setString(lua_State *lua, const char *key, const std::string &value)
+    {
+        lua_pushlstring(lua, value.c_str(), value.size());
+        lua_setfield(lua, -2, key);
+    }
+
+    inline void setBool(lua_State *lua, const char *key, bool value)
+    {
+        lua_pushboolean(lua, value);
+        lua_setfield(lua, -2, key);
+    }
+
+    // Getters for the fields of the table on top of the stack, returning defaultValue for missing fields
+
+    inline lua_Number getNumber(lua_State *lua, const char *key, lua_Number defaultValue)
+    {
+        lua_getfield(lua, -1, key);
+        lua_Number value = lua_isnumber(lua, -1) ? lua_tonumber(lua, -1) : defaultValue;
+        lua_pop(lua, 1);
+        return value;
+    }
+
+    inline std::string getString(lua_State *lua, const char *key, const std::string &defaultValue)
+    {
+        lua_getfield(lua, -1, key);
+
+        std::string value = defaultValue;
+
+        if (lua_isstring(lua, -1))
+        {
+            size_t length;
+            const char *data = lua_tolstring(lua, -1, &length);
+            value.assign(data, length);
+        }
+
+        lua_pop(lua, 1);
+        return value;
+    }
+
+    inline bool getBool(lua_State *lua, const char *key, bool defaultValue)
+    {
+        lua_getfield(lua, -1, key);
+        bool value = lua_isnil(lua, -1) ? defaultValue : lua_toboolean(lua, -1) != 0;
+        lua_pop(lua, 1);
+        return value;
+    }
+
+    void setPosition(lua_State *lua, const ESM::Position &position);
+    void getPosition(lua_State *lua, ESM::Position &position);
+
+    // Push a new table with the fields every kind of item has
+    void pushItem(lua_State *lua, const std::string &refId, int count, int charge, double enchantmentCharge,
+        const std::string &soul);
+
+    // Push a new table with the fields of an object, including its container items
+    //
+    // The summoner's pid is left to the caller, because only the server can tell which player a GUID belongs to
+    void pushObject(lua_State *lua, const mwmp::BaseObject &object);
+
+    // Read the table on top of the stack into an object, leaving out the summoner's pid like pushObject()
+    void readObject(lua_State *lua, mwmp::BaseObject &object);
+}
+
+#endif //OPENMW_LUATABLEFIELDS_HPP
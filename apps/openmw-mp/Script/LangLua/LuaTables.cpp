@@ -0,0 +1,254 @@
+#include "LangLua.hpp"
+#include "LuaTableFields.hpp"
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+#include <apps/openmw-mp/Player.hpp>
+#include <apps/openmw-mp/Utils.hpp>
+
+// The lists the per-field functions in Script/Functions read from and write to
+extern mwmp::BaseObjectList *readObjectList;
+extern mwmp::BaseObjectList writeObjectList;
+extern mwmp::BaseActorList *readActorList;
+extern mwmp::BaseActorList writeActorList;
+
+using namespace LuaTableFields;
+
+namespace
+{
+    // Base, current and modified value keys of health, magicka and fatigue
+    const char *dynamicStatKeys[3][3] = {
+        {"healthBase", "healthCurrent", "healthModified"},
+        {"magickaBase", "magickaCurrent", "magickaModified"},
+        {"fatigueBase", "fatigueCurrent", "fatigueModified"}
+    };
+
+    const mwmp::BaseActor emptyActor = {};
+
+    // Check that the argument is a table and return its number of entries
+    size_t checkList(lua_State *lua, int index)
+    {
+        luaL_checktype(lua, index, LUA_TTABLE);
+        return lua_objlen(lua, index);
+    }
+}
+
+int LangLua::GetObjectListTable(lua_State *lua)
+{
+    if (readObjectList == nullptr)
+    {
+        lua_createtable(lua, 0, 0);
+        return 1;
+    }
+
+    const std::vector<mwmp::BaseObject> &objects = readObjectList->baseObjects;
+    const size_t objectCount = std::min<size_t>(readObjectList->baseObjectCount, objects.size());
+
+    lua_createtable(lua, (int) objectCount, 0);
+
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        const mwmp::BaseObject &object = objects[i];
+
+        pushObject(lua, object);
+
+        Player *summoner = Players::getPlayer(object.master.guid);
+        setNumber(lua, "summonerPid", summoner != nullptr ? summoner->getId() : -1);
+
+        lua_rawseti(lua, -2, (int) i + 1);
+    }
+
+    return 1;
+}
+
+int LangLua::AddObjectsFromTable(lua_State *lua)
+{
+    const size_t objectCount = checkList(lua, 1);
+
+    writeObjectList.baseObjects.reserve(writeObjectList.baseObjects.size() + objectCount);
+
+    for (size_t i = 1; i <= objectCount; i++)
+    {
+        lua_rawgeti(lua, 1, (int) i);
+
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            continue;
+        }
+
+        mwmp::BaseObject object = {};
+        readObject(lua, object);
+
+        int summonerPid = (int) getNumber(lua, "summonerPid", -1);
+
+        if (summonerPid >= 0)
+        {
+            Player *summoner = Players::getPlayer((unsigned short) summonerPid);
+
+            if (summoner != nullptr)
+            {
+                object.master.isPlayer = true;
+                object.master.guid = summoner->guid;
+            }
+        }
+
+        lua_pop(lua, 1);
+
+        writeObjectList.baseObjects.push_back(std::move(object));
+    }
+
+    return 0;
+}
+
+int LangLua::GetInventoryChangesTable(lua_State *lua)
+{
+    unsigned short pid = luabridge::Stack<unsigned short>::get(lua, 1);
+    Player *player = Players::getPlayer(pid);
+
+    if (player == nullptr)
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "%s: Player with pid \'%d\' not found\n", __PRETTY_FUNCTION__, pid);
+        lua_createtable(lua, 0, 0);
+        return 1;
+    }
+
+    const std::vector<mwmp::Item> &items = player->inventoryChanges.items;
+
+    lua_createtable(lua, (int) items.size(), 0);
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const mwmp::Item &item = items[i];
+
+        pushItem(lua, item.refId, item.count, item.charge, item.enchantmentCharge, item.soul);
+        lua_rawseti(lua, -2, (int) i + 1);
+    }
+
+    return 1;
+}
+
+int LangLua::AddItemChangesFromTable(lua_State *lua)
+{
+    unsigned short pid = luabridge::Stack<unsigned short>::get(lua, 1);
+    const size_t itemCount = checkList(lua, 2);
+
+    Player *player = Players::getPlayer(pid);
+
+    if (player == nullptr)
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "%s: Player with pid \'%d\' not found\n", __PRETTY_FUNCTION__, pid);
+        return 0;
+    }
+
+    std::vector<mwmp::Item> &items = player->inventoryChanges.items;
+    items.reserve(items.size() + itemCount);
+
+    for (size_t i = 1; i <= itemCount; i++)
+    {
+        lua_rawgeti(lua, 2, (int) i);
+
+        if (lua_istable(lua, -1))
+        {
+            mwmp::Item item;
+            item.refId = getString(lua, "refId", "");
+            item.count = (int) getNumber(lua, "count", 1);
+            item.charge = (int) getNumber(lua, "charge", -1);
+            item.enchantmentCharge = (float) getNumber(lua, "enchantmentCharge", -1);
+            item.soul = getString(lua, "soul", "");
+
+            items.push_back(item);
+        }
+
+        lua_pop(lua, 1);
+    }
+
+    return 0;
+}
+
+int LangLua::GetActorListTable(lua_State *lua)
+{
+    if (readActorList == nullptr)
+    {
+        lua_createtable(lua, 0, 0);
+        return 1;
+    }
+
+    const std::vector<mwmp::BaseActor> &actors = readActorList->baseActors;
+    const size_t actorCount = std::min<size_t>(readActorList->count, actors.size());
+
+    lua_createtable(lua, (int) actorCount, 0);
+
+    for (size_t i = 0; i < actorCount; i++)
+    {
+        const mwmp::BaseActor &actor = actors[i];
+
+        lua_createtable(lua, 0, 20);
+        setString(lua, "cellDescription", actor.cell.getShortDescription());
+        setString(lua, "refId", actor.refId);
+        setNumber(lua, "refNum", actor.refNum);
+        setNumber(lua, "mpNum", actor.mpNum);
+
+        if (actor.hasPositionData)
+            setPosition(lua, actor.position);
+
+        if (actor.hasStatsDynamicData)
+        {
+            for (int stat = 0; stat < 3; stat++)
+            {
+                const ESM::StatState<float> &dynamic = actor.creatureStats.mDynamic[stat];
+                setNumber(lua, dynamicStatKeys[stat][0], dynamic.mBase);
+                setNumber(lua, dynamicStatKeys[stat][1], dynamic.mCurrent);
+                setNumber(lua, dynamicStatKeys[stat][2], dynamic.mMod);
+            }
+        }
+
+        lua_rawseti(lua, -2, (int) i + 1);
+    }
+
+    return 1;
+}
+
+int LangLua::AddActorsFromTable(lua_State *lua)
+{
+    const size_t actorCount = checkList(lua, 1);
+
+    writeActorList.baseActors.reserve(writeActorList.baseActors.size() + actorCount);
+
+    for (size_t i = 1; i <= actorCount; i++)
+    {
+        lua_rawgeti(lua, 1, (int) i);
+
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            continue;
+        }
+
+        mwmp::BaseActor actor = emptyActor;
+
+        std::string cellDescription = getString(lua, "cellDescription", "");
+        if (!cellDescription.empty())
+            actor.cell = Utils::getCellFromDescription(cellDescription);
+
+        actor.refId = getString(lua, "refId", "");
+        actor.refNum = (unsigned int) getNumber(lua, "refNum", 0);
+        actor.mpNum = (unsigned int) getNumber(lua, "mpNum", 0);
+        getPosition(lua, actor.position);
+
+        for (int stat = 0; stat < 3; stat++)
+        {
+            ESM::StatState<float> &dynamic = actor.creatureStats.mDynamic[stat];
+            dynamic.mBase = (float) getNumber(lua, dynamicStatKeys[stat][0], dynamic.mBase);
+            dynamic.mCurrent = (float) getNumber(lua, dynamicStatKeys[stat][1], dynamic.mCurrent);
+            dynamic.mMod = (float) getNumber(lua, dynamicStatKeys[stat][2], dynamic.mMod);
+        }
+
+        lua_pop(lua, 1);
+
+        writeActorList.baseActors.push_back(std::move(actor));
+    }
+
+    return 0;
+}
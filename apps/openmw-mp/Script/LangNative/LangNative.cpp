@@ -68,16 +68,6 @@ bool LangNative::IsCallbackPresent(const char *name)
     return true;
 }
 
-boost::any LangNative::Call(const char *name, const char *argl, int buf, ...)
-{
-    return nullptr;
-}
-
-boost::any LangNative::Call(const char *name, const char *argl, const std::vector<boost::any> &args)
-{
-    return nullptr;
-}
-
 
 lib_t LangNative::GetInterface()
 {
@@ -15,8 +15,6 @@ public:
     virtual void LoadProgram(const char *filename) override;
     virtual int FreeProgram() override;
     virtual bool IsCallbackPresent(const char *name) override;
-    virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
-    virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
 
 };
 
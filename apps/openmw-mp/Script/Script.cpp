@@ -7,6 +7,7 @@
 
 Script::ScriptList Script::scripts;
 std::string Script::moddir;
+unsigned int Script::callbackSlots = 0;
 
 Script::Script(const char *path)
 {
@@ -56,6 +57,24 @@ Script::~Script()
     delete lang;
 }
 
+void Script::ResolveCallback(CallbackHandle &callback, const char *name)
+{
+    if (script_type == SCRIPT_CPP)
+    {
+        callback.native = SystemInterface<FunctionEllipsis<void>>(lang->GetInterface(), name).result;
+        callback.present = callback.native != nullptr;
+    }
+#if defined (ENABLE_LUA)
+    else if (script_type == SCRIPT_LUA)
+    {
+        callback.luaRef = static_cast<LangLua*>(lang)->ResolveCallback(name);
+        callback.present = callback.luaRef != LUA_NOREF;
+    }
+#endif
+
+    callback.resolved = true;
+}
+
 void Script::LoadScripts(char *scripts, const char *base)
 {
     char *token = strtok(scripts, ",");
@@ -4,6 +4,7 @@
 #include <boost/any.hpp>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "Types.hpp"
 #include "SystemInterface.hpp"
@@ -11,7 +12,12 @@
 #include "ScriptFunctions.hpp"
 #include "Language.hpp"
 
+#if defined (ENABLE_LUA)
+#include "LangLua/LangLua.hpp"
+#endif
+
 #include "Networking.hpp"
+#include "Profiler.hpp"
 
 class Script : private ScriptFunctions
 {
@@ -26,21 +32,42 @@ private:
         SCRIPT_LUA
     };
 
-    template<typename R>
-    R GetScript(const char *name)
+    // A callback of this script, looked up the first time it gets called
+    struct CallbackHandle
     {
-        if (script_type == SCRIPT_CPP)
-        {
-            return SystemInterface<R>(lang->GetInterface(), name).result;
-        }
-        else
-        {
-            return reinterpret_cast<R>(lang->IsCallbackPresent(name));
-        }
-    }
+        bool resolved = false;
+        bool present = false;
+        FunctionEllipsis<void> native = nullptr;
+        int luaRef = 0;
+    };
 
     int script_type;
-    std::unordered_map<unsigned int, FunctionEllipsis<void>> callbacks_;
+    std::vector<CallbackHandle> callbacks_;
+
+    // Every callback identity gets its own slot in callbacks_, handed out on its first call
+    static unsigned int callbackSlots;
+
+    template<unsigned int I>
+    static unsigned int CallbackSlot()
+    {
+        static const unsigned int slot = callbackSlots++;
+        return slot;
+    }
+
+    CallbackHandle &GetCallback(unsigned int slot, const char *name)
+    {
+        if (slot >= callbacks_.size())
+            callbacks_.resize(slot + 1);
+
+        CallbackHandle &callback = callbacks_[slot];
+
+        if (!callback.resolved)
+            ResolveCallback(callback, name);
+
+        return callback;
+    }
+
+    void ResolveCallback(CallbackHandle &callback, const char *name);
 
     typedef std::vector<std::unique_ptr<Script>> ScriptList;
     static ScriptList scripts;
@@ -77,26 +104,25 @@ public:
         static_assert(data.callback.matches(TypeString<typename std::remove_reference<Args>::type...>::value),
                       "Wrong number or types of arguments");
 
+        const unsigned int slot = CallbackSlot<I>();
         unsigned int count = 0;
+        Profiler::CallbackTimer timer(slot, data.name);
 
         for (auto& script : scripts)
         {
-            if (!script->callbacks_.count(I))
-                script->callbacks_.emplace(I, script->GetScript<FunctionEllipsis<void>>(data.name));
-
-            auto callback = script->callbacks_[I];
+            const CallbackHandle &callback = script->GetCallback(slot, data.name);
 
-            if (!callback)
+            if (!callback.present)
                 continue;
 
             if (script->script_type == SCRIPT_CPP)
-                (callback)(std::forward<Args>(args)...);
+                (callback.native)(std::forward<Args>(args)...);
 #if defined (ENABLE_LUA)
             else if (script->script_type == SCRIPT_LUA)
             {
                 try
                 {
-                    script->lang->Call(data.name, data.callback.types, B, std::forward<Args>(args)...);
+                    static_cast<LangLua*>(script->lang)->CallCallback(callback.luaRef, std::forward<Args>(args)...);
                 }
                 catch (std::exception &e)
                 {
@@ -0,0 +1,101 @@
+#include "ScriptArguments.hpp"
+
+#include <stdexcept>
+
+ScriptArguments::ScriptArguments(const ScriptArguments &other) : count(0)
+{
+    *this = other;
+}
+
+ScriptArguments &ScriptArguments::operator=(const ScriptArguments &other)
+{
+    if (this == &other)
+        return *this;
+
+    for (unsigned int i = 0; i < inlineCapacity; i++)
+        inlineArgs[i] = other.inlineArgs[i];
+
+    extraArgs = other.extraArgs;
+    count = other.count;
+    strings.clear();
+
+    // Point at copies of our own rather than at the strings of the other arguments
+    if (!other.strings.empty())
+        KeepStrings();
+
+    return *this;
+}
+
+void ScriptArguments::KeepStrings()
+{
+    std::vector<std::string> keptStrings;
+    keptStrings.reserve(count);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        ScriptArgument &argument = At(i);
+
+        if (argument.type == 's')
+        {
+            keptStrings.emplace_back(argument.s != nullptr ? argument.s : "");
+            argument.s = keptStrings.back().c_str();
+        }
+    }
+
+    // Moving the vector keeps its elements, and with them the pointers above, where they are
+    strings = std::move(keptStrings);
+}
+
+void ScriptArguments::ReadVaList(va_list args, const std::string &def)
+{
+    try
+    {
+        for (char c : def)
+        {
+            switch (c)
+            {
+            case 'i':
+                Add(c).i = va_arg(args, unsigned int);
+                break;
+
+            case 'q':
+                Add(c).q = va_arg(args, signed int);
+                break;
+
+            case 'l':
+                Add(c).l = va_arg(args, unsigned long long);
+                break;
+
+            case 'w':
+                Add(c).w = va_arg(args, signed long long);
+                break;
+
+            case 'f':
+                Add(c).f = va_arg(args, double);
+                break;
+
+            case 'p':
+                Add(c).p = va_arg(args, void*);
+                break;
+
+            case 's':
+                Add(c).s = va_arg(args, const char*);
+                break;
+
+            case 'b':
+                Add(c).b = va_arg(args, int) != 0;
+                break;
+
+            default:
+                throw std::runtime_error("C++ call: Unknown argument identifier " + std::string(1, c));
+            }
+        }
+    }
+
+    catch (...)
+    {
+        va_end(args);
+        throw;
+    }
+    va_end(args);
+}
@@ -0,0 +1,93 @@
+#ifndef SCRIPTARGUMENTS_HPP
+#define SCRIPTARGUMENTS_HPP
+
+#include <cstdarg>
+#include <string>
+#include <vector>
+
+// A single argument or return value, tagged with its type character from Types.hpp
+struct ScriptArgument
+{
+    char type;
+
+    union
+    {
+        unsigned int i;
+        signed int q;
+        unsigned long long l;
+        signed long long w;
+        double f;
+        void *p;
+        const char *s;
+        bool b;
+    };
+
+    ScriptArgument() : type('v'), l(0) {}
+};
+
+/*
+    Arguments passed to publics and timers
+
+    Up to inlineCapacity arguments are kept without any allocation. Strings are only pointed to, so
+    arguments that are kept past the call that produced them need KeepStrings() first.
+*/
+class ScriptArguments
+{
+public:
+    static const unsigned int inlineCapacity = 8;
+
+    ScriptArguments() : count(0) {}
+    ScriptArguments(const ScriptArguments &other);
+    ScriptArguments &operator=(const ScriptArguments &other);
+
+    // Append an argument of this type, returning it so its value can be set
+    ScriptArgument &Add(char type)
+    {
+        ScriptArgument *argument;
+
+        if (count < inlineCapacity)
+            argument = &inlineArgs[count];
+        else
+        {
+            if (count == inlineCapacity)
+                extraArgs.assign(inlineArgs, inlineArgs + inlineCapacity);
+
+            extraArgs.emplace_back();
+            argument = &extraArgs.back();
+        }
+
+        count++;
+        argument->type = type;
+        return *argument;
+    }
+
+    unsigned int Size() const
+    {
+        return count;
+    }
+
+    const ScriptArgument &operator[](unsigned int index) const
+    {
+        return count <= inlineCapacity ? inlineArgs[index] : extraArgs[index];
+    }
+
+    // Copy the strings pointed to into storage owned by these arguments
+    void KeepStrings();
+
+    // Read arguments of the types in def from a va_list
+    void ReadVaList(va_list args, const std::string &def);
+
+private:
+    ScriptArgument &At(unsigned int index)
+    {
+        return count <= inlineCapacity ? inlineArgs[index] : extraArgs[index];
+    }
+
+    ScriptArgument inlineArgs[inlineCapacity];
+    // Holds every argument instead once there are more than inlineCapacity of them
+    std::vector<ScriptArgument> extraArgs;
+    unsigned int count;
+    std::vector<std::string> strings;
+};
+
+#endif //SCRIPTARGUMENTS_HPP
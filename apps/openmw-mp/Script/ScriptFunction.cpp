@@ -28,40 +28,100 @@ ScriptFunction::~ScriptFunction()
 #endif
 }
 
-boost::any ScriptFunction::Call(const std::vector<boost::any> &args)
+ScriptArgument ScriptFunction::Call(const ScriptArguments &args)
 {
-    boost::any result;
+    ScriptArgument result;
 
-    if (def.length() != args.size())
+    if (def.length() != args.Size())
         throw std::runtime_error("Script call: Number of arguments does not match definition");
 #if defined (ENABLE_LUA)
     else if (script_type == SCRIPT_LUA)
     {
-        LangLua langLua(fLua.lua);
-        boost::any any = langLua.Call(fLua.name.c_str(), def.c_str(), args);
+        lua_State *lua = fLua.lua;
+        lua_getglobal(lua, fLua.name.c_str());
+
+        for (unsigned int index = 0; index < args.Size(); index++)
+        {
+            const ScriptArgument &arg = args[index];
+
+            switch (def[index])
+            {
+                case 'i':
+                    luabridge::Stack<unsigned int>::push(lua, arg.i);
+                    break;
+
+                case 'q':
+                    luabridge::Stack<signed int>::push(lua, arg.q);
+                    break;
+
+                case 'l':
+                    luabridge::Stack<unsigned long long>::push(lua, arg.l);
+                    break;
+
+                case 'w':
+                    luabridge::Stack<signed long long>::push(lua, arg.w);
+                    break;
+
+                case 'f':
+                    luabridge::Stack<double>::push(lua, arg.f);
+                    break;
+
+                case 'p':
+                    luabridge::Stack<void *>::push(lua, arg.p);
+                    break;
+
+                case 's':
+                    luabridge::Stack<const char *>::push(lua, arg.s);
+                    break;
+
+                case 'b':
+                    luabridge::Stack<bool>::push(lua, arg.b);
+                    break;
+
+                default:
+                    lua_pop(lua, (int) index + 1);
+                    throw std::runtime_error("Lua call: Unknown argument identifier " + std::string(1, def[index]));
+            }
+        }
+
+        const int resultCount = ret_type == 'v' ? 0 : 1;
+        int err = lua_pcall(lua, (int) args.Size(), resultCount, 0);
+
+        if (err != 0)
+        {
+            luabridge::LuaException exception(lua, err);
+            lua_pop(lua, 1);
+            throw exception;
+        }
+
+        result.type = ret_type;
 
         switch (ret_type)
         {
             case 'i':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<unsigned int>();
+                result.i = luabridge::Stack<unsigned int>::get(lua, -1);
                 break;
             case 'q':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<signed int>();
+                result.q = luabridge::Stack<signed int>::get(lua, -1);
                 break;
             case 'f':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<double>();
+                result.f = luabridge::Stack<double>::get(lua, -1);
                 break;
             case 's':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<const char*>();
+            {
+                const char *value = luabridge::Stack<const char*>::get(lua, -1);
+                returnedString = value != nullptr ? value : "";
+                result.s = returnedString.c_str();
                 break;
+            }
             case 'v':
-                result = boost::any();
                 break;
             default:
-                throw std::runtime_error("Lua call: Unknown return type" + ret_type);
+                lua_pop(lua, resultCount);
+                throw std::runtime_error("Lua call: Unknown return type " + std::string(1, ret_type));
         }
 
-        lua_settop(fLua.lua, 0);
+        lua_pop(lua, resultCount);
     }
 #endif
 
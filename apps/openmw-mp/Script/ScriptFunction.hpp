@@ -1,9 +1,11 @@
 #ifndef SCRIPTFUNCTION_HPP
 #define SCRIPTFUNCTION_HPP
 
-#include <boost/any.hpp>
 #include <string>
 #include <vector>
+
+#include "ScriptArguments.hpp"
+
 #if defined (ENABLE_LUA)
 #include "LangLua/LangLua.hpp"
 #endif
@@ -44,7 +46,11 @@ protected:
 #endif
     virtual ~ScriptFunction();
 
-    boost::any Call(const std::vector<boost::any> &args);
+    // Returns a value of type ret_type, with returned strings staying valid until the next call
+    ScriptArgument Call(const ScriptArguments &args);
+
+private:
+    std::string returnedString;
 };
 
 #endif //SCRIPTFUNCTION_HPP
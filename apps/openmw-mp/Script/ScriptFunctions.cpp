@@ -18,14 +18,31 @@ void ScriptFunctions::MakePublic(ScriptFunc _public, const char *name, char ret_
 
 boost::any ScriptFunctions::CallPublic(const char *name, va_list args) noexcept
 {
-    std::vector<boost::any> params;
+    ScriptArguments params;
 
     try
     {
-        std::string def = Public::GetDefinition(name);
-        Utils::getArguments(params, args, def);
+        int handle = Public::GetHandle(name);
+        if (handle == -1)
+            return 0;
 
-        return Public::Call(name, params);
+        params.ReadVaList(args, Public::GetDefinition(handle));
+
+        ScriptArgument result = Public::Call(handle, params);
+
+        switch (result.type)
+        {
+            case 'i':
+                return result.i;
+            case 'q':
+                return result.q;
+            case 'f':
+                return result.f;
+            case 's':
+                return result.s;
+            default:
+                return boost::any();
+        }
     }
     catch (...) {}
 
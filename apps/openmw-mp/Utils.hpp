@@ -25,8 +25,6 @@ namespace Utils
 
     ESM::Cell getCellFromDescription(std::string cellDescription);
 
-    void getArguments(std::vector<boost::any> &params, va_list args, const std::string &def);
-
     template<size_t N>
     constexpr unsigned int hash(const char(&str)[N], size_t I = N)
     {
@@ -22,6 +22,8 @@
 
 #include "Player.hpp"
 #include "Networking.hpp"
+#include "InterestManager.hpp"
+#include "Profiler.hpp"
 #include "MasterClient.hpp"
 #include "Utils.hpp"
 
@@ -186,7 +188,7 @@ int main(int argc, char *argv[])
         std::cerr.rdbuf(&cerrsb);
     }
 
-    LOG_INIT(logLevel);
+    LOG_INIT_ASYNC(logLevel);
 
     int players = mgr.getInt("maximumPlayers", "General");
     std::string address = mgr.getString("localAddress", "General");
@@ -231,6 +233,7 @@ int main(int argc, char *argv[])
     if (RakNet::NonNumericHostString(address.c_str()))
     {
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "You cannot use non-numeric addresses for the server.");
+        LOG_QUIT();
         return 1;
     }
 
@@ -267,6 +270,16 @@ int main(int argc, char *argv[])
 
         Networking networking(peer);
         networking.setServerPassword(password);
+        networking.setLoopPacing(mgr.getInt("tickInterval", "Loop"), mgr.getInt("maximumWait", "Loop"));
+        networking.setDecoderThreads(mgr.getInt("decoderThreads", "Loop"));
+        networking.setBatchWindow(mgr.getInt("batchWindow", "Loop"));
+        networking.setPositionDeltas(mgr.getBool("positionDeltas", "Broadcasting"));
+
+        InterestManager::get()->setRadius(mgr.getInt("interestRadius", "Broadcasting"));
+
+        Profiler::setDumpFile((cfgMgr.getLogPath() / "tes3mp-server-profile.json").string(),
+            mgr.getInt("dumpInterval", "Profiler"));
+        Profiler::setEnabled(mgr.getBool("enabled", "Profiler"));
 
         if (mgr.getBool("enabled", "MasterServer"))
         {
@@ -310,6 +323,8 @@ int main(int argc, char *argv[])
     {
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, e.what());
         Script::Call<Script::CallbackIdentity("OnServerScriptCrash")>(e.what());
+        // The exception ends the process, so get the error written while it still can be
+        TimedLog::Flush();
         throw; //fall through
     }
 
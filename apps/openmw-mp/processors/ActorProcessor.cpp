@@ -12,32 +12,48 @@ void ActorProcessor::Do(ActorPacket &packet, Player &player, BaseActorList &acto
 }
 
 bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept
+{
+    if (!processors[packet.data[0]])
+        return false;
+
+    ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+    Read(packet, actorList, *myPacket);
+
+    return Dispatch(packet, actorList);
+}
+
+void ActorProcessor::Read(RakNet::Packet &packet, BaseActorList &actorList, ActorPacket &myPacket) noexcept
 {
     // Clear our BaseActorList before loading new data in it
     actorList.cell.blank();
     actorList.baseActors.clear();
     actorList.guid = packet.guid;
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+    myPacket.setActorList(&actorList);
+    actorList.isValid = true;
+
+    auto &processor = processors[packet.data[0]];
+
+    if (processor && !processor->avoidReading)
+        myPacket.Read();
+}
+
+bool ActorProcessor::Dispatch(RakNet::Packet &packet, BaseActorList &actorList) noexcept
+{
+    auto &processor = processors[packet.data[0]];
+
+    if (!processor)
+        return false;
 
-            myPacket->setActorList(&actorList);
-            actorList.isValid = true;
+    Player *player = Players::getPlayer(packet.guid);
+    ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+    myPacket->setActorList(&actorList);
 
-            if (actorList.isValid)
-                processor.second->Do(*myPacket, *player, actorList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
+    if (actorList.isValid)
+        processor->Do(*myPacket, *player, actorList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
 
-            return true;
-        }
-    }
-    return false;
+    return true;
 }
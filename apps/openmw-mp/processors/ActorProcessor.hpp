@@ -18,6 +18,12 @@ namespace mwmp
         virtual void Do(ActorPacket &packet, Player &player, BaseActorList &actorList);
 
         static bool Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept;
+
+        // Read a packet into actorList using a packet object owned by the calling thread, so packets
+        // can be read away from the main thread before being processed on it
+        static void Read(RakNet::Packet &packet, BaseActorList &actorList, ActorPacket &myPacket) noexcept;
+        // Process a packet that has already been read into actorList
+        static bool Dispatch(RakNet::Packet &packet, BaseActorList &actorList) noexcept;
     };
 }
 
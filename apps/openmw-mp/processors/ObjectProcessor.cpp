@@ -12,32 +12,48 @@ void ObjectProcessor::Do(ObjectPacket &packet, Player &player, BaseObjectList &o
 }
 
 bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
+{
+    if (!processors[packet.data[0]])
+        return false;
+
+    ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
+    Read(packet, objectList, *myPacket);
+
+    return Dispatch(packet, objectList);
+}
+
+void ObjectProcessor::Read(RakNet::Packet &packet, BaseObjectList &objectList, ObjectPacket &myPacket) noexcept
 {
     // Clear our BaseObjectList before loading new data in it
     objectList.cell.blank();
     objectList.baseObjects.clear();
     objectList.guid = packet.guid;
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
-
-            myPacket->setObjectList(&objectList);
-            objectList.isValid = true;
-
-            if (!processor.second->avoidReading)
-                myPacket->Read();
-
-            if (objectList.isValid)
-                processor.second->Do(*myPacket, *player, objectList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-            
-            return true;
-        }
-    }
-    return false;
+    myPacket.setObjectList(&objectList);
+    objectList.isValid = true;
+
+    auto &processor = processors[packet.data[0]];
+
+    if (processor && !processor->avoidReading)
+        myPacket.Read();
+}
+
+bool ObjectProcessor::Dispatch(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
+{
+    auto &processor = processors[packet.data[0]];
+
+    if (!processor)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
+
+    myPacket->setObjectList(&objectList);
+
+    if (objectList.isValid)
+        processor->Do(*myPacket, *player, objectList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
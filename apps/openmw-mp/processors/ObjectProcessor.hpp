@@ -18,6 +18,12 @@ namespace mwmp
         virtual void Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList);
 
         static bool Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
+
+        // Read a packet into objectList using a packet object owned by the calling thread, so packets
+        // can be read away from the main thread before being processed on it
+        static void Read(RakNet::Packet &packet, BaseObjectList &objectList, ObjectPacket &myPacket) noexcept;
+        // Process a packet that has already been read into objectList
+        static bool Dispatch(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
     };
 }
 
@@ -8,20 +8,18 @@ typename BasePacketProcessor<T>::processors_t BasePacketProcessor<T>::processors
 
 bool PlayerProcessor::Process(RakNet::Packet &packet) noexcept
 {
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
-            myPacket->setPlayer(player);
+    auto &processor = processors[packet.data[0]];
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+    if (!processor)
+        return false;
 
-            processor.second->Do(*myPacket, *player);
-            return true;
-        }
-    }
-    return false;
+    Player *player = Players::getPlayer(packet.guid);
+    PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
+    myPacket->setPlayer(player);
+
+    if (!processor->avoidReading)
+        myPacket->Read();
+
+    processor->Do(*myPacket, *player);
+    return true;
 }
@@ -12,29 +12,45 @@ void WorldstateProcessor::Do(WorldstatePacket &packet, Player &player, BaseWorld
 }
 
 bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept
+{
+    if (!processors[packet.data[0]])
+        return false;
+
+    WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
+    Read(packet, worldstate, *myPacket);
+
+    return Dispatch(packet, worldstate);
+}
+
+void WorldstateProcessor::Read(RakNet::Packet &packet, BaseWorldstate &worldstate, WorldstatePacket &myPacket) noexcept
 {
     worldstate.guid = packet.guid;
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
-
-            myPacket->setWorldstate(&worldstate);
-            worldstate.isValid = true;
-
-            if (!processor.second->avoidReading)
-                myPacket->Read();
-
-            if (worldstate.isValid)
-                processor.second->Do(*myPacket, *player, worldstate);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-            
-            return true;
-        }
-    }
-    return false;
+    myPacket.setWorldstate(&worldstate);
+    worldstate.isValid = true;
+
+    auto &processor = processors[packet.data[0]];
+
+    if (processor && !processor->avoidReading)
+        myPacket.Read();
+}
+
+bool WorldstateProcessor::Dispatch(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept
+{
+    auto &processor = processors[packet.data[0]];
+
+    if (!processor)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
+
+    myPacket->setWorldstate(&worldstate);
+
+    if (worldstate.isValid)
+        processor->Do(*myPacket, *player, worldstate);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
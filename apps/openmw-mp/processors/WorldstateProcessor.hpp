@@ -16,6 +16,12 @@ namespace mwmp
         virtual void Do(WorldstatePacket &packet, Player &player, BaseWorldstate &worldstate);
 
         static bool Process(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept;
+
+        // Read a packet into worldstate using a packet object owned by the calling thread, so packets
+        // can be read away from the main thread before being processed on it
+        static void Read(RakNet::Packet &packet, BaseWorldstate &worldstate, WorldstatePacket &myPacket) noexcept;
+        // Process a packet that has already been read into worldstate
+        static bool Dispatch(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept;
     };
 }
 
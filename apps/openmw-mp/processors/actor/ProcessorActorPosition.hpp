@@ -20,8 +20,9 @@ namespace mwmp
 
             if (serverCell != nullptr && *serverCell->getAuthority() == actorList.guid)
             {
+                serverCell->decodePositions(&actorList);
                 serverCell->readActorList(packetID, &actorList);
-                serverCell->sendToLoaded(&packet, &actorList);
+                serverCell->sendPositionsToLoaded(&packet, &actorList);
             }
         }
     };
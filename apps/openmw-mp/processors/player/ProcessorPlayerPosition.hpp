@@ -15,7 +15,11 @@ namespace mwmp
 
         void Do(PlayerPacket &packet, Player &player) override
         {
-            player.sendToLoaded(&packet);
+            if (packet.isPacketValid() && player.positionStream.decode(player.positionUpdate, player.position, player.direction))
+                player.sendPositionToLoaded(&packet);
+
+            // Anything else the server sends about this player's position is a full update
+            player.positionUpdate.type = PositionUpdate::FULL;
         }
     };
 }
@@ -56,26 +56,26 @@ void Cell::updateLocal(bool forceUpdate)
         if (newStore != store)
         {
             actor->updateCell();
-            std::string mapIndex = it->first;
+            uint64_t mapIndex = it->first;
 
             // If the cell this actor has moved to is under our authority, move them to it
             if (cellController->hasLocalAuthority(actor->cell))
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %s to our authority in %s",
-                    mapIndex.c_str(), actor->cell.getShortDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %i-%i to our authority in %s",
+                    actor->refNum, actor->mpNum, actor->cell.getShortDescription().c_str());
                 Cell *newCell = cellController->getCell(actor->cell);
                 newCell->localActors[mapIndex] = actor;
-                cellController->setLocalActorRecord(mapIndex, newCell->getShortDescription());
+                cellController->setLocalActorRecord(mapIndex, newCell);
             }
             else
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s which is no longer under our authority",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %i-%i which is no longer under our authority",
+                    actor->refNum, actor->mpNum);
                 cellController->removeLocalActorRecord(mapIndex);
                 delete actor;
             }
 
-            localActors.erase(it++);
+            it = localActors.erase(it);
         }
         else
         {
@@ -83,12 +83,12 @@ void Cell::updateLocal(bool forceUpdate)
             {
                 if (actor->getPtr().getRefData().isDeleted())
                 {
-                    std::string mapIndex = it->first;
-                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s whose reference has been deleted",
-                        mapIndex.c_str(), getShortDescription().c_str());
-                    cellController->removeLocalActorRecord(mapIndex);
+                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %i-%i whose reference has been deleted",
+                        actor->refNum, actor->mpNum);
+                    cellController->removeLocalActorRecord(it->first);
                     delete actor;
-                    localActors.erase(it++);
+                    it = localActors.erase(it);
+                    continue;
                 }
                 else
                 {
@@ -135,13 +135,24 @@ void Cell::readPositions(ActorList& actorList)
     
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->position = baseActor.position;
-            actor->direction = baseActor.direction;
+            DedicatedActor *actor = it->second;
+
+            if (baseActor.positionUpdate.type == PositionUpdate::FULL)
+            {
+                actor->position = baseActor.position;
+                actor->direction = baseActor.direction;
+            }
+            // Deltas only apply on top of the keyframe and deltas before them, so wait for the
+            // next keyframe after missing any of those
+            else if (!actor->positionStream.decode(baseActor.positionUpdate, actor->position, actor->direction))
+                continue;
+
+            actor->addSnapshot(baseActor.positionUpdate);
 
             if (!actor->hasPositionData)
             {
@@ -162,11 +173,12 @@ void Cell::readAnimFlags(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->movementFlags = baseActor.movementFlags;
             actor->drawState = baseActor.drawState;
             actor->isFlying = baseActor.isFlying;
@@ -178,11 +190,12 @@ void Cell::readAnimPlay(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->animation.groupname = baseActor.animation.groupname;
             actor->animation.mode = baseActor.animation.mode;
             actor->animation.count = baseActor.animation.count;
@@ -200,11 +213,12 @@ void Cell::readStatsDynamic(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats = baseActor.creatureStats;
 
             if (!actor->hasStatsDynamicData)
@@ -230,11 +244,12 @@ void Cell::readDeath(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats.mDead = true;
             actor->creatureStats.mDynamic[0].mCurrent = 0;
 
@@ -261,11 +276,12 @@ void Cell::readEquipment(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
 
             for (int slot = 0; slot < 19; ++slot)
                 actor->equipmentItems[slot] = baseActor.equipmentItems[slot];
@@ -286,11 +302,12 @@ void Cell::readSpeech(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->sound = baseActor.sound;
             actor->playSound();
         }
@@ -308,11 +325,12 @@ void Cell::readSpellsActive(ActorList& actorList)
 
     for (const auto& baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor* actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->spellsActiveChanges = baseActor.spellsActiveChanges;
 
             int spellsActiveAction = baseActor.spellsActiveChanges.action;
@@ -338,11 +356,12 @@ void Cell::readAi(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->aiAction = baseActor.aiAction;
             actor->aiDistance = baseActor.aiDistance;
             actor->aiDuration = baseActor.aiDuration;
@@ -362,13 +381,14 @@ void Cell::readAttack(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %i-%i", baseActor.refNum, baseActor.mpNum);
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->attack = baseActor.attack;
 
             MechanicsHelper::processAttack(actor->attack, actor->getPtr());
@@ -380,13 +400,14 @@ void Cell::readCast(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %i-%i", baseActor.refNum, baseActor.mpNum);
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->cast = baseActor.cast;
 
             // Set the correct drawState here if we've somehow we've missed a previous
@@ -412,25 +433,27 @@ void Cell::readCellChange(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
 
         // Is a packet mistakenly moving the actor to the cell it's already in? If so, ignore it
         if (Misc::StringUtils::ciEqual(getShortDescription(), baseActor.cell.getShortDescription()))
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %s moved to %s, but it was already there",
-                mapIndex.c_str(), getShortDescription().c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %i-%i moved to %s, but it was already there",
+                baseActor.refNum, baseActor.mpNum, getShortDescription().c_str());
             continue;
         }
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        auto it = dedicatedActors.find(mapIndex);
+
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *dedicatedActor = dedicatedActors[mapIndex];
+            DedicatedActor *dedicatedActor = it->second;
             dedicatedActor->cell = baseActor.cell;
             dedicatedActor->position = baseActor.position;
             dedicatedActor->direction = baseActor.direction;
 
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %s moved to %s",
-                mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %i-%i moved to %s",
+                baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getShortDescription().c_str());
 
             MWWorld::CellStore *newStore = cellController->getCellStore(dedicatedActor->cell);
             dedicatedActor->setCell(newStore);
@@ -438,19 +461,19 @@ void Cell::readCellChange(ActorList& actorList)
             // If the cell this actor has moved to is active and not under our authority, move them to it
             if (cellController->isActiveWorldCell(dedicatedActor->cell) && !cellController->hasLocalAuthority(dedicatedActor->cell))
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %s to our active cell %s",
-                    mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %i-%i to our active cell %s",
+                    baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getShortDescription().c_str());
                 cellController->initializeCell(dedicatedActor->cell);
                 Cell *newCell = cellController->getCell(dedicatedActor->cell);
                 newCell->dedicatedActors[mapIndex] = dedicatedActor;
-                cellController->setDedicatedActorRecord(mapIndex, newCell->getShortDescription());
+                cellController->setDedicatedActorRecord(mapIndex, newCell);
             }
             else
             {
                 if (cellController->hasLocalAuthority(dedicatedActor->cell))
                 {
-                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %s in %s",
-                        mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %i-%i in %s",
+                        baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getShortDescription().c_str());
                     Cell *newCell = cellController->getCell(dedicatedActor->cell);
                     LocalActor *localActor = new LocalActor();
                     localActor->cell = dedicatedActor->cell;
@@ -463,24 +486,25 @@ void Cell::readCellChange(ActorList& actorList)
                     localActor->creatureStats = dedicatedActor->creatureStats;
 
                     newCell->localActors[mapIndex] = localActor;
-                    cellController->setLocalActorRecord(mapIndex, newCell->getShortDescription());
+                    cellController->setLocalActorRecord(mapIndex, newCell);
                 }
 
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %s which is no longer needed",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %i-%i which is no longer needed",
+                    baseActor.refNum, baseActor.mpNum);
                 cellController->removeDedicatedActorRecord(mapIndex);
                 delete dedicatedActor;
             }
 
-            dedicatedActors.erase(mapIndex);
+            dedicatedActors.erase(it);
         }
     }
 }
 
 void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    uint64_t mapIndex = CellController::generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %i-%i in %s", ptr.getCellRef().getRefNum().mIndex,
+        ptr.getCellRef().getMpNum(), getShortDescription().c_str());
 
     LocalActor *actor = new LocalActor();
     actor->cell = *store->getCell();
@@ -488,9 +512,10 @@ void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 
     localActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setLocalActorRecord(mapIndex, getShortDescription());
+    Main::get().getCellController()->setLocalActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %i-%i in %s", actor->refNum, actor->mpNum,
+        getShortDescription().c_str());
 }
 
 void Cell::initializeLocalActors()
@@ -509,7 +534,7 @@ void Cell::initializeLocalActors()
             // If this Ptr is disabled or deleted, ignore it
             if (!ptr.getRefData().isEnabled() || ptr.getRefData().isDeleted()) continue;
 
-            std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+            uint64_t mapIndex = CellController::generateMapIndex(ptr);
 
             // Only initialize this actor if it isn't already initialized
             if (localActors.count(mapIndex) == 0)
@@ -522,8 +547,9 @@ void Cell::initializeLocalActors()
 
 void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    uint64_t mapIndex = CellController::generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %i-%i in %s", ptr.getCellRef().getRefNum().mIndex,
+        ptr.getCellRef().getMpNum(), getShortDescription().c_str());
 
     DedicatedActor *actor = new DedicatedActor();
     actor->cell = *store->getCell();
@@ -531,16 +557,17 @@ void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 
     dedicatedActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, getShortDescription());
+    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %i-%i in %s", actor->refNum, actor->mpNum,
+        getShortDescription().c_str());
 }
 
 void Cell::initializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
 
         // If this key doesn't exist, create it
         if (dedicatedActors.count(mapIndex) == 0)
@@ -569,10 +596,15 @@ void Cell::uninitializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(mapIndex);
+
+        if (it == dedicatedActors.end())
+            continue;
+
         Main::get().getCellController()->removeDedicatedActorRecord(mapIndex);
-        delete dedicatedActors.at(mapIndex);
-        dedicatedActors.erase(mapIndex);
+        delete it->second;
+        dedicatedActors.erase(it);
     }
 }
 
@@ -587,12 +619,18 @@ void Cell::uninitializeDedicatedActors()
     dedicatedActors.clear();
 }
 
-LocalActor *Cell::getLocalActor(std::string actorIndex)
+void Cell::clearDedicatedActorSnapshots()
+{
+    for (const auto &actor : dedicatedActors)
+        actor.second->clearSnapshots();
+}
+
+LocalActor *Cell::getLocalActor(uint64_t actorIndex)
 {
     return localActors.at(actorIndex);
 }
 
-DedicatedActor *Cell::getDedicatedActor(std::string actorIndex)
+DedicatedActor *Cell::getDedicatedActor(uint64_t actorIndex)
 {
     return dedicatedActors.at(actorIndex);
 }
@@ -1,6 +1,9 @@
 #ifndef OPENMW_MPCELL_HPP
 #define OPENMW_MPCELL_HPP
 
+#include <cstdint>
+#include <unordered_map>
+
 #include "ActorList.hpp"
 #include "LocalActor.hpp"
 #include "DedicatedActor.hpp"
@@ -40,9 +43,11 @@ namespace mwmp
         void uninitializeLocalActors();
         void uninitializeDedicatedActors(ActorList& actorList);
         void uninitializeDedicatedActors();
+        // Forget the received positions of every DedicatedActor, such as when they start coming from someone else
+        void clearDedicatedActorSnapshots();
 
-        virtual LocalActor *getLocalActor(std::string actorIndex);
-        virtual DedicatedActor *getDedicatedActor(std::string actorIndex);
+        virtual LocalActor *getLocalActor(uint64_t actorIndex);
+        virtual DedicatedActor *getDedicatedActor(uint64_t actorIndex);
 
         bool hasLocalAuthority();
         void setAuthority(const RakNet::RakNetGUID& guid);
@@ -56,8 +61,9 @@ namespace mwmp
         MWWorld::CellStore* store;
         RakNet::RakNetGUID authorityGuid;
 
-        std::map<std::string, LocalActor *> localActors;
-        std::map<std::string, DedicatedActor *> dedicatedActors;
+        // Keyed by CellController::generateMapIndex()
+        std::unordered_map<uint64_t, LocalActor *> localActors;
+        std::unordered_map<uint64_t, DedicatedActor *> dedicatedActors;
 
         float updateTimer;
     };
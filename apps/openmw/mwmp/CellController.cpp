@@ -16,9 +16,10 @@
 using namespace mwmp;
 
 std::map<std::string, mwmp::Cell *> CellController::cellsInitialized;
-std::map<std::string, std::string> CellController::localActorsToCells;
-std::map<std::string, std::string> CellController::dedicatedActorsToCells;
-std::map<std::string, unsigned int> CellController::queuedDeathStates;
+CellIndex<mwmp::Cell> CellController::cellIndex;
+std::unordered_map<uint64_t, mwmp::Cell *> CellController::localActorsToCells;
+std::unordered_map<uint64_t, mwmp::Cell *> CellController::dedicatedActorsToCells;
+std::unordered_map<uint64_t, unsigned int> CellController::queuedDeathStates;
 
 mwmp::CellController::CellController()
 {
@@ -43,6 +44,7 @@ void CellController::updateLocal(bool forceUpdate)
         {
             mpCell->uninitializeLocalActors();
             mpCell->uninitializeDedicatedActors();
+            removeFromCellIndex(mpCell);
             delete it->second;
             cellsInitialized.erase(it++);
         }
@@ -83,38 +85,48 @@ void CellController::updateDedicated(float dt)
         cell.second->updateDedicated(dt);
 }
 
-void CellController::initializeCell(const ESM::Cell& cell)
+Cell *CellController::initializeCell(const ESM::Cell& cell)
 {
-    std::string mapIndex = cell.getShortDescription();
+    mwmp::Cell *mpCell = cellIndex.get(cell);
 
-    // If this key doesn't exist, create it
-    if (cellsInitialized.count(mapIndex) == 0)
+    // If this cell isn't initialized, initialize it
+    if (mpCell == nullptr)
     {
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Initializing mwmp::Cell %s", cell.getShortDescription().c_str());
 
         MWWorld::CellStore *cellStore = getCellStore(cell);
 
-        if (!cellStore) return;
+        if (!cellStore) return nullptr;
 
-        mwmp::Cell *mpCell = new mwmp::Cell(cellStore);
-        cellsInitialized[mapIndex] = mpCell;
+        // Index the cell the way its CellStore describes it, which is also how it gets removed from the index
+        const ESM::Cell &storeCell = *cellStore->getCell();
+        mpCell = cellIndex.get(storeCell);
+
+        if (mpCell == nullptr)
+        {
+            mpCell = new mwmp::Cell(cellStore);
+            cellsInitialized[storeCell.getShortDescription()] = mpCell;
+            cellIndex.add(storeCell, mpCell);
+        }
 
         LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized mwmp::Cell %s", cell.getShortDescription().c_str());
     }
+
+    return mpCell;
 }
 
 void CellController::uninitializeCell(const ESM::Cell& cell)
 {
-    std::string mapIndex = cell.getShortDescription();
+    mwmp::Cell *mpCell = cellIndex.get(cell);
 
-    // If this key exists, erase the key-value pair from the map
-    if (cellsInitialized.count(mapIndex) > 0)
+    // If this cell is initialized, delete it
+    if (mpCell != nullptr)
     {
-        mwmp::Cell* mpCell = cellsInitialized.at(mapIndex);
         mpCell->uninitializeLocalActors();
         mpCell->uninitializeDedicatedActors();
-        delete cellsInitialized.at(mapIndex);
-        cellsInitialized.erase(mapIndex);
+        removeFromCellIndex(mpCell);
+        cellsInitialized.erase(mpCell->getShortDescription());
+        delete mpCell;
     }
 }
 
@@ -131,175 +143,174 @@ void CellController::uninitializeCells()
         }
 
         cellsInitialized.clear();
+        cellIndex.clear();
     }
 }
 
 void CellController::readPositions(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readPositions(actorList);
+    if (mpCell != nullptr)
+        mpCell->readPositions(actorList);
 }
 
 void CellController::readAnimFlags(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readAnimFlags(actorList);
+    if (mpCell != nullptr)
+        mpCell->readAnimFlags(actorList);
 }
 
 void CellController::readAnimPlay(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readAnimPlay(actorList);
+    if (mpCell != nullptr)
+        mpCell->readAnimPlay(actorList);
 }
 
 void CellController::readStatsDynamic(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readStatsDynamic(actorList);
+    if (mpCell != nullptr)
+        mpCell->readStatsDynamic(actorList);
 }
 
 void CellController::readDeath(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readDeath(actorList);
+    if (mpCell != nullptr)
+        mpCell->readDeath(actorList);
 }
 
 void CellController::readEquipment(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readEquipment(actorList);
+    if (mpCell != nullptr)
+        mpCell->readEquipment(actorList);
 }
 
 void CellController::readSpeech(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readSpeech(actorList);
+    if (mpCell != nullptr)
+        mpCell->readSpeech(actorList);
 }
 
 void CellController::readSpellsActive(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readSpellsActive(actorList);
+    if (mpCell != nullptr)
+        mpCell->readSpellsActive(actorList);
 }
 
 void CellController::readAi(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readAi(actorList);
+    if (mpCell != nullptr)
+        mpCell->readAi(actorList);
 }
 
 void CellController::readAttack(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readAttack(actorList);
+    if (mpCell != nullptr)
+        mpCell->readAttack(actorList);
 }
 
 void CellController::readCast(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readCast(actorList);
+    if (mpCell != nullptr)
+        mpCell->readCast(actorList);
 }
 
 void CellController::readCellChange(ActorList& actorList)
 {
-    std::string mapIndex = actorList.cell.getShortDescription();
-
-    initializeCell(actorList.cell);
+    mwmp::Cell *mpCell = initializeCell(actorList.cell);
 
     // If this now exists, send it the data
-    if (cellsInitialized.count(mapIndex) > 0)
-        cellsInitialized[mapIndex]->readCellChange(actorList);
+    if (mpCell != nullptr)
+        mpCell->readCellChange(actorList);
+}
+
+void CellController::removeFromCellIndex(mwmp::Cell *mpCell)
+{
+    MWWorld::CellStore *cellStore = mpCell->getCellStore();
+
+    if (cellStore != nullptr && cellStore->getCell() != nullptr)
+    {
+        cellIndex.remove(*cellStore->getCell(), mpCell);
+        return;
+    }
+
+    // Without its ESM::Cell, this cell's entry can't be found, so index the other cells again instead
+    cellIndex.clear();
+
+    for (const auto &cell : cellsInitialized)
+    {
+        MWWorld::CellStore *otherCellStore = cell.second->getCellStore();
+
+        if (cell.second != mpCell && otherCellStore != nullptr && otherCellStore->getCell() != nullptr)
+            cellIndex.add(*otherCellStore->getCell(), cell.second);
+    }
 }
 
 bool CellController::hasQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates.count(actorIndex) > 0;
 }
 
 unsigned int CellController::getQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates[actorIndex];
 }
 
 void CellController::clearQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates.erase(actorIndex);
 }
 
 void CellController::setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates[actorIndex] = deathState;
 }
 
-void CellController::setLocalActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setLocalActorRecord(uint64_t actorIndex, Cell *cell)
 {
-    localActorsToCells[actorIndex] = cellIndex;
+    localActorsToCells[actorIndex] = cell;
 }
 
-void CellController::removeLocalActorRecord(std::string actorIndex)
+void CellController::removeLocalActorRecord(uint64_t actorIndex)
 {
     localActorsToCells.erase(actorIndex);
 }
@@ -309,40 +320,38 @@ bool CellController::isLocalActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 LocalActor *CellController::getLocalActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
-    return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
+    return localActorsToCells.at(actorIndex)->getLocalActor(actorIndex);
 }
 
 LocalActor *CellController::getLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
-    return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
+    return localActorsToCells.at(actorIndex)->getLocalActor(actorIndex);
 }
 
-void CellController::setDedicatedActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setDedicatedActorRecord(uint64_t actorIndex, Cell *cell)
 {
-    dedicatedActorsToCells[actorIndex] = cellIndex;
+    dedicatedActorsToCells[actorIndex] = cell;
 }
 
-void CellController::removeDedicatedActorRecord(std::string actorIndex)
+void CellController::removeDedicatedActorRecord(uint64_t actorIndex)
 {
     dedicatedActorsToCells.erase(actorIndex);
 }
@@ -352,47 +361,43 @@ bool CellController::isDedicatedActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 DedicatedActor *CellController::getDedicatedActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
-    return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
+    return dedicatedActorsToCells.at(actorIndex)->getDedicatedActor(actorIndex);
 }
 
 DedicatedActor *CellController::getDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
-    return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
+    return dedicatedActorsToCells.at(actorIndex)->getDedicatedActor(actorIndex);
 }
 
-std::string CellController::generateMapIndex(int refNum, int mpNum)
+uint64_t CellController::generateMapIndex(int refNum, int mpNum)
 {
-    std::string mapIndex = "";
-    mapIndex = Utils::toString(refNum) + "-" + Utils::toString(mpNum);
-    return mapIndex;
+    return ((uint64_t) (uint32_t) refNum << 32) | (uint32_t) mpNum;
 }
 
-std::string CellController::generateMapIndex(MWWorld::Ptr ptr)
+uint64_t CellController::generateMapIndex(const MWWorld::Ptr& ptr)
 {
     return generateMapIndex(ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum());
 }
 
-std::string CellController::generateMapIndex(BaseActor baseActor)
+uint64_t CellController::generateMapIndex(const BaseActor& baseActor)
 {
     return generateMapIndex(baseActor.refNum, baseActor.mpNum);
 }
@@ -412,7 +417,7 @@ bool CellController::isInitializedCell(const std::string& cellDescription)
 
 bool CellController::isInitializedCell(const ESM::Cell& cell)
 {
-    return isInitializedCell(cell.getShortDescription());
+    return cellIndex.get(cell) != nullptr;
 }
 
 bool CellController::isActiveWorldCell(const ESM::Cell& cell)
@@ -422,7 +427,7 @@ bool CellController::isActiveWorldCell(const ESM::Cell& cell)
 
 Cell *CellController::getCell(const ESM::Cell& cell)
 {
-    return cellsInitialized.at(cell.getShortDescription());
+    return cellIndex.get(cell);
 }
 
 MWWorld::CellStore *CellController::getCellStore(const ESM::Cell& cell)
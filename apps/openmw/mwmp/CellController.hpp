@@ -1,6 +1,10 @@
 #ifndef OPENMW_CELLCONTROLLER_HPP
 #define OPENMW_CELLCONTROLLER_HPP
 
+#include <cstdint>
+#include <unordered_map>
+#include <components/openmw-mp/CellIndex.hpp>
+
 #include "Cell.hpp"
 #include "ActorList.hpp"
 #include "LocalActor.hpp"
@@ -19,7 +23,8 @@ namespace mwmp
         void updateLocal(bool forceUpdate);
         void updateDedicated(float dt);
 
-        void initializeCell(const ESM::Cell& cell);
+        // Returns nullptr if the cell's CellStore could not be found
+        Cell *initializeCell(const ESM::Cell& cell);
         void uninitializeCell(const ESM::Cell& cell);
         void uninitializeCells();
 
@@ -41,30 +46,32 @@ namespace mwmp
         void clearQueuedDeathState(MWWorld::Ptr ptr);
         void setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState);
 
-        void setLocalActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeLocalActorRecord(std::string actorIndex);
+        void setLocalActorRecord(uint64_t actorIndex, Cell *cell);
+        void removeLocalActorRecord(uint64_t actorIndex);
         
         bool isLocalActor(MWWorld::Ptr ptr);
         bool isLocalActor(int refNum, int mpNum);
         virtual LocalActor *getLocalActor(MWWorld::Ptr ptr);
         virtual LocalActor *getLocalActor(int refNum, int mpNum);
 
-        void setDedicatedActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeDedicatedActorRecord(std::string actorIndex);
+        void setDedicatedActorRecord(uint64_t actorIndex, Cell *cell);
+        void removeDedicatedActorRecord(uint64_t actorIndex);
         
         bool isDedicatedActor(MWWorld::Ptr ptr);
         bool isDedicatedActor(int refNum, int mpNum);
         virtual DedicatedActor *getDedicatedActor(MWWorld::Ptr ptr);
         virtual DedicatedActor *getDedicatedActor(int refNum, int mpNum);
 
-        std::string generateMapIndex(int refNumindex, int mpNum);
-        std::string generateMapIndex(MWWorld::Ptr ptr);
-        std::string generateMapIndex(mwmp::BaseActor baseActor);
+        // Actors are keyed by their refNum and mpNum packed together
+        static uint64_t generateMapIndex(int refNum, int mpNum);
+        static uint64_t generateMapIndex(const MWWorld::Ptr& ptr);
+        static uint64_t generateMapIndex(const mwmp::BaseActor& baseActor);
 
         bool hasLocalAuthority(const ESM::Cell& cell);
         bool isInitializedCell(const std::string& cellDescription);
         bool isInitializedCell(const ESM::Cell& cell);
         bool isActiveWorldCell(const ESM::Cell& cell);
+        // Returns nullptr for cells that aren't initialized
         virtual Cell *getCell(const ESM::Cell& cell);
 
         virtual MWWorld::CellStore *getCellStore(const ESM::Cell& cell);
@@ -74,10 +81,15 @@ namespace mwmp
         int getCellSize() const;
 
     private:
+        static void removeFromCellIndex(mwmp::Cell *mpCell);
+
+        // Owns the initialized cells, keyed by their short descriptions
         static std::map<std::string, mwmp::Cell *> cellsInitialized;
-        static std::map<std::string, std::string> localActorsToCells;
-        static std::map<std::string, std::string> dedicatedActorsToCells;
-        static std::map<std::string, unsigned int> queuedDeathStates;
+        // Finds the initialized cells for packets without building their descriptions
+        static CellIndex<mwmp::Cell> cellIndex;
+        static std::unordered_map<uint64_t, mwmp::Cell *> localActorsToCells;
+        static std::unordered_map<uint64_t, mwmp::Cell *> dedicatedActorsToCells;
+        static std::unordered_map<uint64_t, unsigned int> queuedDeathStates;
     };
 }
 
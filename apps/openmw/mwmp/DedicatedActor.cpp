@@ -1,4 +1,5 @@
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/settings/settings.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/soundmanager.hpp"
@@ -46,6 +47,9 @@ DedicatedActor::DedicatedActor()
 
     attack.pressed = false;
     cast.pressed = false;
+
+    snapshots.setInterpolationDelay(Settings::Manager::getFloat("interpolationDelay", "Movement"));
+    snapshots.setExtrapolationLimit(Settings::Manager::getFloat("extrapolationLimit", "Movement"));
 }
 
 DedicatedActor::~DedicatedActor()
@@ -70,55 +74,48 @@ void DedicatedActor::setCell(MWWorld::CellStore *cellStore)
     MWBase::World *world = MWBase::Environment::get().getWorld();
 
     ptr = world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]);
-    setMovementSettings();
+    setMovementSettings(direction);
 
+    // Positions from the previous cell are not worth interpolating from
+    snapshots.clear();
     hasChangedCell = true;
 }
 
 void DedicatedActor::move(float dt)
 {
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate = abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    ESM::Position shownPosition = position;
+    ESM::Position shownDirection = direction;
+    snapshots.sample(SnapshotBuffer::getTime(), shownPosition, shownDirection);
 
-    // Don't apply linear interpolation if the DedicatedActor has just gone through a cell change, because
-    // the interpolated position will be invalid, causing a slight hopping glitch
-    if (shouldInterpolate && !hasChangedCell)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-        refPos.pos[0] = lerp.x();
-        refPos.pos[1] = lerp.y();
-        refPos.pos[2] = lerp.z();
-
-        world->moveObject(ptr, refPos.pos[0], refPos.pos[1], refPos.pos[2]);
-    }
-    else
+    // Don't place the DedicatedActor anywhere but its newest position right after a cell change, because
+    // anything else will be invalid, causing a slight hopping glitch
+    if (hasChangedCell)
     {
         setPosition();
         hasChangedCell = false;
     }
+    else
+        world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
 
-    setMovementSettings();
-    world->rotateObject(ptr, position.rot[0], position.rot[1], position.rot[2]);
+    setMovementSettings(shownDirection);
+    world->rotateObject(ptr, shownPosition.rot[0], shownPosition.rot[1], shownPosition.rot[2]);
 }
 
-void DedicatedActor::setMovementSettings()
+void DedicatedActor::setMovementSettings(const ESM::Position &movementDirection)
 {
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
-    move->mPosition[0] = direction.pos[0];
-    move->mPosition[1] = direction.pos[1];
-    move->mPosition[2] = direction.pos[2];
+    move->mPosition[0] = movementDirection.pos[0];
+    move->mPosition[1] = movementDirection.pos[1];
+    move->mPosition[2] = movementDirection.pos[2];
 
     // Make sure the values are valid, or we'll get an infinite error loop
-    if (!isnan(direction.rot[0]) && !isnan(direction.rot[1]) && !isnan(direction.rot[2]))
+    if (!isnan(movementDirection.rot[0]) && !isnan(movementDirection.rot[1]) && !isnan(movementDirection.rot[2]))
     {
-        move->mRotation[0] = direction.rot[0];
-        move->mRotation[1] = direction.rot[1];
-        move->mRotation[2] = direction.rot[2];
+        move->mRotation[0] = movementDirection.rot[0];
+        move->mRotation[1] = movementDirection.rot[1];
+        move->mRotation[2] = movementDirection.rot[2];
     }
 }
 
@@ -128,6 +125,20 @@ void DedicatedActor::setPosition()
     world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
 }
 
+void DedicatedActor::addSnapshot(const PositionUpdate &update)
+{
+    // Updates without a stamp from their sender are placed at the time they arrived
+    if (update.type == PositionUpdate::FULL)
+        snapshots.push(SnapshotBuffer::getTime(), position, direction);
+    else
+        snapshots.push(SnapshotBuffer::getTime(), update.time, position, direction);
+}
+
+void DedicatedActor::clearSnapshots()
+{
+    snapshots.clear();
+}
+
 void DedicatedActor::setAnimFlags()
 {
     using namespace MWMechanics;
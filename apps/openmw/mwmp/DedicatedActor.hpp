@@ -1,6 +1,7 @@
 #ifndef OPENMW_DEDICATEDACTOR_HPP
 #define OPENMW_DEDICATEDACTOR_HPP
 
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 #include <components/openmw-mp/Base/BaseActor.hpp>
 #include "../mwmechanics/aisequence.hpp"
 #include "../mwworld/manualref.hpp"
@@ -17,8 +18,11 @@ namespace mwmp
         void update(float dt);
         void move(float dt);
         void setCell(MWWorld::CellStore *cellStore);
-        void setMovementSettings();
+        void setMovementSettings(const ESM::Position &movementDirection);
         void setPosition();
+        // Remember the newly received position for move() to interpolate towards
+        void addSnapshot(const PositionUpdate &update);
+        void clearSnapshots();
         void setAnimFlags();
         void setStatsDynamic();
         void setEquipment();
@@ -40,6 +44,8 @@ namespace mwmp
     private:
         MWWorld::Ptr ptr;
 
+        SnapshotBuffer snapshots;
+
         bool hasReceivedInitialEquipment;
         bool hasChangedCell;
     };
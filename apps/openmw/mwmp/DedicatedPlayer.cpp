@@ -1,5 +1,6 @@
 #include <boost/algorithm/clamp.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/settings/settings.hpp>
 #include <apps/openmw/mwmechanics/steering.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -67,6 +68,9 @@ DedicatedPlayer::DedicatedPlayer(RakNet::RakNetGUID guid) : BasePlayer(guid)
 
     isJumping = false;
     wasJumping = false;
+
+    snapshots.setInterpolationDelay(Settings::Manager::getFloat("interpolationDelay", "Movement"));
+    snapshots.setExtrapolationLimit(Settings::Manager::getFloat("extrapolationLimit", "Movement"));
 }
 
 DedicatedPlayer::~DedicatedPlayer()
@@ -118,42 +122,38 @@ void DedicatedPlayer::move(float dt)
 {
     if (!reference) return;
 
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 80;
-
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate =
-            abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
-            abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
-            abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
-
-    if (shouldInterpolate)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
 
-        world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
-    }
-    else
-        world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
+    ESM::Position shownPosition = position;
+    ESM::Position shownDirection = direction;
+    snapshots.sample(SnapshotBuffer::getTime(), shownPosition, shownDirection);
 
-    world->rotateObject(ptr, position.rot[0], 0, position.rot[2]);
+    world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
+    world->rotateObject(ptr, shownPosition.rot[0], 0, shownPosition.rot[2]);
 
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
-    move->mPosition[0] = direction.pos[0];
-    move->mPosition[1] = direction.pos[1];
-    move->mPosition[2] = direction.pos[2];
+    move->mPosition[0] = shownDirection.pos[0];
+    move->mPosition[1] = shownDirection.pos[1];
+    move->mPosition[2] = shownDirection.pos[2];
 
     // Make sure the values are valid, or we'll get an infinite error loop
-    if (!isnan(direction.rot[0]) && !isnan(direction.rot[1]) && !isnan(direction.rot[2]))
+    if (!isnan(shownDirection.rot[0]) && !isnan(shownDirection.rot[1]) && !isnan(shownDirection.rot[2]))
     {
-        move->mRotation[0] = direction.rot[0];
-        move->mRotation[1] = direction.rot[1];
-        move->mRotation[2] = direction.rot[2];
+        move->mRotation[0] = shownDirection.rot[0];
+        move->mRotation[1] = shownDirection.rot[1];
+        move->mRotation[2] = shownDirection.rot[2];
     }
 }
 
+void DedicatedPlayer::addSnapshot(const PositionUpdate &update)
+{
+    // Updates without a stamp from their sender are placed at the time they arrived
+    if (update.type == PositionUpdate::FULL)
+        snapshots.push(SnapshotBuffer::getTime(), position, direction);
+    else
+        snapshots.push(SnapshotBuffer::getTime(), update.time, position, direction);
+}
+
 void DedicatedPlayer::setBaseInfo()
 {
     // Use the previous race if the new one doesn't exist
@@ -417,6 +417,9 @@ void DedicatedPlayer::setCell()
     // update has been called
     setPtr(world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]));
 
+    // Positions from the previous cell are not worth interpolating from
+    snapshots.clear();
+
     // Remove the marker entirely if this player has moved to an interior that is inactive for us
     if (!cell.isExterior() && !Main::get().getCellController()->isActiveWorldCell(cell))
         removeMarker();
@@ -4,6 +4,7 @@
 #include <components/esm/custommarkerstate.hpp>
 #include <components/esm/loadcrea.hpp>
 #include <components/esm/loadnpc.hpp>
+#include <components/openmw-mp/SnapshotBuffer.hpp>
 #include <components/openmw-mp/Base/BasePlayer.hpp>
 
 #include "../mwclass/npc.hpp"
@@ -31,6 +32,8 @@ namespace mwmp
         void update(float dt);
 
         void move(float dt);
+        // Remember the newly received position for move() to interpolate towards
+        void addSnapshot(const PositionUpdate &update);
         void setBaseInfo();
         void setStatsDynamic();
         void setAnimFlags();
@@ -73,6 +76,8 @@ namespace mwmp
 
         MWWorld::Ptr ptr;
 
+        SnapshotBuffer snapshots;
+
         ESM::CustomMarker marker;
         bool markerEnabled;
 
@@ -12,6 +12,7 @@
 #include "../mwworld/worldimp.hpp"
 
 #include "LocalActor.hpp"
+#include "LocalSystem.hpp"
 #include "Main.hpp"
 #include "Networking.hpp"
 #include "ActorList.hpp"
@@ -106,6 +107,18 @@ void LocalActor::updatePosition(bool forceUpdate)
     {
         posWasChanged = posIsChanging;
         position = ptr.getRefData().getPosition();
+
+        if (mwmp::Main::get().getLocalSystem()->usesPositionDeltas())
+        {
+            // The update that ends a movement is a keyframe, so late receivers see where we stopped
+            if (forceUpdate || !posIsChanging)
+                positionStream.requestKeyframe();
+
+            positionStream.encode(position, direction, positionUpdate);
+        }
+        else
+            positionUpdate.type = PositionUpdate::FULL;
+
         mwmp::Main::get().getNetworking()->getActorList()->addPositionActor(*this);
     }
 }
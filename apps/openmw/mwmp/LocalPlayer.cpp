@@ -35,6 +35,7 @@
 #include "../mwworld/worldimp.hpp"
 
 #include "LocalPlayer.hpp"
+#include "LocalSystem.hpp"
 #include "Main.hpp"
 #include "Networking.hpp"
 #include "PlayerList.hpp"
@@ -396,6 +397,10 @@ void LocalPlayer::updatePosition(bool forceUpdate)
         if (!isJumping && !world->isOnGround(ptrPlayer) && !world->isFlying(ptrPlayer))
             isJumping = true;
 
+        // Make the update that ends a movement a keyframe, so players who started receiving
+        // our positions halfway through it still end up seeing where we stopped
+        encodePosition(forceUpdate || !posIsChanging);
+
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
@@ -409,11 +414,55 @@ void LocalPlayer::updatePosition(bool forceUpdate)
     {
         sentJumpEnd = true;
         position = ptrPlayer.getRefData().getPosition();
+        encodePosition(true);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
 }
 
+void LocalPlayer::encodePosition(bool keyframe)
+{
+    if (!Main::get().getLocalSystem()->usesPositionDeltas())
+    {
+        positionUpdate.type = PositionUpdate::FULL;
+        return;
+    }
+
+    if (keyframe)
+        positionStream.requestKeyframe();
+
+    positionStream.encode(position, direction, positionUpdate);
+}
+
+void LocalPlayer::getInventoryItems(std::vector<Item> &items)
+{
+    MWWorld::Ptr ptrPlayer = getPlayerPtr();
+    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
+    mwmp::Item item;
+
+    items.clear();
+
+    for (const auto &iter : ptrInventory)
+    {
+        item.refId = iter.getCellRef().getRefId();
+
+        // Skip any items that somehow have clientside-only dynamic IDs
+        if (item.refId.find("$dynamic") != std::string::npos)
+            continue;
+
+        // Skip bound items
+        if (MWBase::Environment::get().getMechanicsManager()->isBoundItem(item.refId))
+            continue;
+
+        item.count = iter.getRefData().getCount();
+        item.charge = iter.getCellRef().getCharge();
+        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
+        item.soul = iter.getCellRef().getSoul();
+
+        items.push_back(item);
+    }
+}
+
 void LocalPlayer::updateCell(bool forceUpdate)
 {
     const ESM::Cell *ptrCell = MWBase::Environment::get().getWorld()->getPlayerPtr().getCell()->getCell();
@@ -505,72 +554,8 @@ void LocalPlayer::updateEquipment(bool forceUpdate)
     }
 }
 
-void LocalPlayer::updateInventory(bool forceUpdate)
+void LocalPlayer::updateInventory()
 {
-    static bool invChanged = false;
-
-    if (forceUpdate)
-        invChanged = true;
-
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
-    mwmp::Item item;
-
-    auto setItem = [](Item &item, const MWWorld::Ptr &iter) {
-        item.refId = iter.getCellRef().getRefId();
-        if (item.refId.find("$dynamic") != std::string::npos)
-            return true;
-        item.count = iter.getRefData().getCount();
-        item.charge = iter.getCellRef().getCharge();
-        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
-        item.soul = iter.getCellRef().getSoul();
-
-        return false;
-    };
-
-    if (!invChanged)
-    {
-        for (const auto &itemOld : inventoryChanges.items)
-        {
-            auto result = ptrInventory.begin();
-            for (; result != ptrInventory.end(); ++result)
-            {
-                if(setItem(item, *result))
-                    continue;
-
-                if (item == itemOld)
-                    break;
-            }
-            if (result == ptrInventory.end())
-            {
-                invChanged = true;
-                break;
-            }
-        }
-    }
-
-    if (!invChanged)
-    {
-        for (const auto &iter : ptrInventory)
-        {
-            if(setItem(item, iter))
-                continue;
-
-            auto items = inventoryChanges.items;
-
-            if (find(items.begin(), items.end(), item) == items.end())
-            {
-                invChanged = true;
-                break;
-            }
-        }
-    }
-
-    if (!invChanged)
-        return;
-
-    invChanged = false;
-
     sendInventory();
 }
 
@@ -1474,31 +1459,7 @@ void LocalPlayer::sendInventory()
 {
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending entire inventory to server");
 
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
-    mwmp::Item item;
-
-    inventoryChanges.items.clear();
-
-    for (const auto &iter : ptrInventory)
-    {
-        item.refId = iter.getCellRef().getRefId();
-
-        // Skip any items that somehow have clientside-only dynamic IDs
-        if (item.refId.find("$dynamic") != std::string::npos)
-            continue;
-
-        // Skip bound items
-        if (MWBase::Environment::get().getMechanicsManager()->isBoundItem(item.refId))
-            continue;
-
-        item.count = iter.getRefData().getCount();
-        item.charge = iter.getCellRef().getCharge();
-        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
-        item.soul = iter.getCellRef().getSoul();
-
-        inventoryChanges.items.push_back(item);
-    }
+    getInventoryItems(inventoryChanges.items);
 
     inventoryChanges.action = InventoryChanges::SET;
     getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
@@ -41,7 +41,7 @@ namespace mwmp
         void updatePosition(bool forceUpdate = false);
         void updateCell(bool forceUpdate = false);
         void updateEquipment(bool forceUpdate = false);
-        void updateInventory(bool forceUpdate = false);
+        void updateInventory();
         void updateAttackOrCast();
         void updateAnimFlags(bool forceUpdate = false);
 
@@ -127,6 +127,12 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
+        // Fill in positionUpdate for the position and direction about to be sent
+        void encodePosition(bool keyframe);
+
+        // Get the items in the inventory that the server should know about
+        void getInventoryItems(std::vector<Item> &items);
+
     };
 }
 
@@ -14,6 +14,11 @@ LocalSystem::~LocalSystem()
 
 }
 
+bool LocalSystem::usesPositionDeltas() const
+{
+    return (positionEncodings & POSITION_ENCODING_DELTA) != 0;
+}
+
 Networking *LocalSystem::getNetworking()
 {
     return mwmp::Main::get().getNetworking();
@@ -2,6 +2,7 @@
 #define OPENMW_LOCALSYSTEM_HPP
 
 #include <components/openmw-mp/Base/BaseSystem.hpp>
+#include <components/openmw-mp/Base/PositionStream.hpp>
 #include <RakNetTypes.h>
 
 namespace mwmp
@@ -14,6 +15,9 @@ namespace mwmp
         LocalSystem();
         virtual ~LocalSystem();
 
+        // Whether the server accepted position deltas for this connection
+        bool usesPositionDeltas() const;
+
     private:
         Networking *getNetworking();
 
@@ -187,6 +187,8 @@ void Main::frame(float dt)
     get().updateWorld(dt);
 
     get().getGUIController()->update(dt);
+
+    get().getNetworking()->flushPackets();
 }
 
 void Main::updateWorld(float dt) const
@@ -195,7 +195,7 @@ std::string listComparison(PacketPreInit::PluginContainer checksums, PacketPreIn
 
 Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemPacketController(peer),
     playerPacketController(peer), actorPacketController(peer), objectPacketController(peer),
-    worldstatePacketController(peer)
+    worldstatePacketController(peer), packetBatcher(peer)
 {
 
     RakNet::SocketDescriptor sd;
@@ -209,12 +209,23 @@ Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemP
     objectPacketController.SetStream(0, &bsOut);
     worldstatePacketController.SetStream(0, &bsOut);
 
+    systemPacketController.SetBatcher(&packetBatcher);
+    playerPacketController.SetBatcher(&packetBatcher);
+    actorPacketController.SetBatcher(&packetBatcher);
+    objectPacketController.SetBatcher(&packetBatcher);
+    worldstatePacketController.SetBatcher(&packetBatcher);
+
     connected = 0;
     ProcessorInitializer();
 }
 
 Networking::~Networking()
 {
+    packetBatcher.flush(true);
+
+    for (auto packet : unpackedPackets)
+        peer->DeallocatePacket(packet);
+
     peer->Shutdown(100);
     peer->CloseConnection(peer->GetSystemAddressFromIndex(0), true, 0);
     RakNet::RakPeerInterface::DestroyInstance(peer);
@@ -225,7 +236,10 @@ void Networking::update()
     RakNet::Packet *packet;
     std::string errmsg = "";
 
-    for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
+    // Packets sent since the end of the last frame's update can go out before we handle new ones
+    packetBatcher.flush();
+
+    for (packet = receive(); packet; peer->DeallocatePacket(packet), packet = receive())
     {
         switch (packet->data[0])
         {
@@ -268,6 +282,32 @@ void Networking::update()
     }
 }
 
+void Networking::flushPackets()
+{
+    packetBatcher.flush();
+}
+
+RakNet::Packet *Networking::receive()
+{
+    if (unpackedPackets.empty())
+    {
+        RakNet::Packet *packet = peer->Receive();
+
+        if (packet == nullptr || packet->length == 0 || packet->data[0] != ID_PACKET_BATCH)
+            return packet;
+
+        PacketBatcher::unpack(peer, *packet, unpackedPackets);
+        peer->DeallocatePacket(packet);
+
+        if (unpackedPackets.empty())
+            return receive();
+    }
+
+    RakNet::Packet *packet = unpackedPackets.front();
+    unpackedPackets.pop_front();
+    return packet;
+}
+
 void Networking::connect(const std::string &ip, unsigned short port, std::vector<std::string> &content, Files::Collections &collections)
 {
     RakNet::SystemAddress master;
@@ -354,25 +394,36 @@ void Networking::connect(const std::string &ip, unsigned short port, std::vector
 
 void Networking::preInit(std::vector<std::string> &content, Files::Collections &collections)
 {
-    PacketPreInit::PluginContainer checksums;
-    std::vector<std::string>::const_iterator it(content.begin());
-    for (int idx = 0; it != content.end(); ++it, ++idx)
+    std::vector<std::string> paths;
+
+    for (const auto &file : content)
     {
-        boost::filesystem::path filename(*it);
+        boost::filesystem::path filename(file);
         const Files::MultiDirCollection& col = collections.getCollection(filename.extension().string());
-        if (col.doesExist(*it))
-        {
-            PacketPreInit::HashList hashList;
-            unsigned crc32 = Utils::crc32Checksum(col.getPath(*it).string());
-            hashList.push_back(crc32);
-            checksums.push_back(make_pair(*it, hashList));
-
-            LOG_APPEND(TimedLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", idx, crc32, col.getPath(*it).string().c_str());
-        }
+        if (col.doesExist(file))
+            paths.push_back(col.getPath(file).string());
         else
             throw std::runtime_error("Plugin doesn't exist.");
     }
 
+    if (!checksumCache)
+    {
+        Files::ConfigurationManager cfgMgr;
+        checksumCache.reset(new ChecksumCache((cfgMgr.getCachePath() / "tes3mp-checksums.txt").string()));
+    }
+
+    std::vector<unsigned int> fileChecksums = checksumCache->getChecksums(paths);
+
+    PacketPreInit::PluginContainer checksums;
+    for (size_t idx = 0; idx < content.size(); ++idx)
+    {
+        PacketPreInit::HashList hashList;
+        hashList.push_back(fileChecksums[idx]);
+        checksums.push_back(make_pair(content[idx], hashList));
+
+        LOG_APPEND(TimedLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", (int) idx, fileChecksums[idx], paths[idx].c_str());
+    }
+
     PacketPreInit packetPreInit(peer);
     RakNet::BitStream bs;
     RakNet::RakNetGUID guid;
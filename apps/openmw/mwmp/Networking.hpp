@@ -3,9 +3,13 @@
 
 #include <RakPeerInterface.h>
 #include <BitStream.h>
+#include <deque>
+#include <memory>
 #include <string>
 
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/PacketBatcher.hpp>
+#include <components/openmw-mp/ChecksumCache.hpp>
 
 #include <components/openmw-mp/Controllers/SystemPacketController.hpp>
 #include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
@@ -31,6 +35,8 @@ namespace mwmp
         ~Networking();
         void connect(const std::string& ip, unsigned short port, std::vector<std::string> &content, Files::Collections &collections);
         void update();
+        // Send the small packets combined since the last update
+        void flushPackets();
 
         SystemPacket *getSystemPacket(RakNet::MessageID id);
         PlayerPacket *getPlayerPacket(RakNet::MessageID id);
@@ -63,11 +69,18 @@ namespace mwmp
         ObjectPacketController objectPacketController;
         WorldstatePacketController worldstatePacketController;
 
+        PacketBatcher packetBatcher;
+        // Created on the first connection, and kept for any later ones
+        std::unique_ptr<ChecksumCache> checksumCache;
+        std::deque<RakNet::Packet*> unpackedPackets;
+
         ActorList actorList;
         ObjectList objectList;
         Worldstate worldstate;
 
         void receiveMessage(RakNet::Packet *packet);
+        // Get the next received packet, with the packets of batches returned one by one
+        RakNet::Packet *receive();
 
         void preInit(std::vector<std::string> &content, Files::Collections &collections);
     };
@@ -49,6 +49,9 @@ namespace mwmp
                         LOG_APPEND(TimedLog::LOG_INFO, "- The new authority is %s", player->npc.mName.c_str());
 
                     cell->uninitializeLocalActors();
+
+                    // The new authority stamps positions with its own clock
+                    cell->clearDedicatedActorSnapshots();
                 }
             }
             else
@@ -20,7 +20,7 @@ namespace mwmp
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received ID_PLAYER_INVENTORY about LocalPlayer from server");
 
             if (isRequest())
-                static_cast<LocalPlayer*>(player)->updateInventory(true);
+                static_cast<LocalPlayer*>(player)->updateInventory();
             else
             {
                 LocalPlayer &localPlayer = static_cast<LocalPlayer&>(*player);
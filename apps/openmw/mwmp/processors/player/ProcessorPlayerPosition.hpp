@@ -28,7 +28,15 @@ namespace mwmp
                     static_cast<LocalPlayer*>(player)->updatePosition(true);
             }
             else if (player != 0) // dedicated player
-                static_cast<DedicatedPlayer*>(player)->updateMarker();
+            {
+                // Deltas only apply on top of the keyframe and deltas before them, so wait for the
+                // next keyframe after missing any of those
+                if (packet.isPacketValid() && player->positionStream.decode(player->positionUpdate, player->position, player->direction))
+                {
+                    static_cast<DedicatedPlayer*>(player)->addSnapshot(player->positionUpdate);
+                    static_cast<DedicatedPlayer*>(player)->updateMarker();
+                }
+            }
         }
     };
 }
@@ -19,8 +19,20 @@ namespace mwmp
 
         virtual void Do(SystemPacket &packet, BaseSystem *system)
         {
-            packet.setSystem(Main::get().getLocalSystem());
-            packet.Send(serverAddr);
+            if (isRequest())
+            {
+                // Offer every position encoding we support, but keep using full positions until
+                // the server's reply tells us which of them it accepted
+                LocalSystem *localSystem = Main::get().getLocalSystem();
+                localSystem->positionEncodings = POSITION_ENCODING_DELTA;
+
+                packet.setSystem(localSystem);
+                packet.Send(serverAddr);
+
+                localSystem->positionEncodings = 0;
+            }
+            else
+                LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Server accepted position encodings %i", system->positionEncodings);
         }
     };
 }
@@ -5,6 +5,21 @@
 namespace MWWorld
 {
 
+    /*
+        Start of tes3mp addition
+
+        Count the changes to reference numbers and mMpNums
+    */
+    unsigned int CellRef::sNumberChanges = 0;
+
+    unsigned int CellRef::getNumberChanges()
+    {
+        return sNumberChanges;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     const ESM::RefNum& CellRef::getRefNum() const
     {
         return mCellRef.mRefNum;
@@ -18,6 +33,16 @@ namespace MWWorld
     void CellRef::unsetRefNum()
     {
         mCellRef.mRefNum.unset();
+
+        /*
+            Start of tes3mp addition
+
+            Count the change to the reference number
+        */
+        sNumberChanges++;
+        /*
+            End of tes3mp addition
+        */
     }
 
     /*
@@ -30,6 +55,7 @@ namespace MWWorld
     void CellRef::setRefNum(unsigned int index)
     {
         mCellRef.mRefNum.mIndex = index;
+        sNumberChanges++;
     }
     /*
         End of tes3mp addition
@@ -56,6 +82,7 @@ namespace MWWorld
     void CellRef::setMpNum(unsigned int index)
     {
         mCellRef.mMpNum = index;
+        sNumberChanges++;
     }
     /*
         End of tes3mp addition
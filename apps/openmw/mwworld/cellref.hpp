@@ -60,6 +60,17 @@ namespace MWWorld
             End of tes3mp addition
         */
 
+        /*
+            Start of tes3mp addition
+
+            Get the number of times the reference number or mMpNum of any CellRef has been changed,
+            so lookups indexed by them can tell when they need to be rebuilt
+        */
+        static unsigned int getNumberChanges();
+        /*
+            End of tes3mp addition
+        */
+
         /// Does the RefNum have a content file?
         bool hasContentFile() const;
 
@@ -184,6 +195,16 @@ namespace MWWorld
     private:
         bool mChanged;
         ESM::CellRef mCellRef;
+
+        /*
+            Start of tes3mp addition
+
+            Count the changes to reference numbers and mMpNums
+        */
+        static unsigned int sNumberChanges;
+        /*
+            End of tes3mp addition
+        */
     };
 
 }
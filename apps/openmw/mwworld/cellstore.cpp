@@ -448,6 +448,18 @@ namespace MWWorld
     {
         mMergedRefs.clear();
         mRechargingItemsUpToDate = false;
+
+        /*
+            Start of tes3mp addition
+
+            The index of mMergedRefs no longer matches it
+        */
+        mExactIndexUpToDate = false;
+        mExactIndexStaleSearches = 0;
+        /*
+            End of tes3mp addition
+        */
+
         MergeVisitor visitor(mMergedRefs, mMovedHere, mMovedToAnotherCell);
         forEachInternal(visitor);
         visitor.merge();
@@ -483,6 +495,15 @@ namespace MWWorld
 
     CellStore::CellStore (const ESM::Cell *cell, const MWWorld::ESMStore& esmStore, std::vector<ESM::ESMReader>& readerList)
         : mStore(esmStore), mReader(readerList), mCell (cell), mState (State_Unloaded), mHasState (false), mLastRespawn(0,0), mRechargingItemsUpToDate(false)
+        /*
+            Start of tes3mp addition
+
+            Initialize the index of mMergedRefs
+        */
+        , mExactIndexUpToDate(false), mExactIndexNumberChanges(0), mExactIndexStaleSearches(0)
+        /*
+            End of tes3mp addition
+        */
     {
         mWaterLevel = cell->mWater;
     }
@@ -633,6 +654,59 @@ namespace MWWorld
         End of tes3mp addition
     */
 
+    /*
+        Start of tes3mp addition
+
+        Rebuilding the index takes about as long as this many searches through every reference of a cell,
+        whatever its size, so rebuilding it only after this many searches keeps cells that keep changing
+        from being slower to search than without it
+    */
+    static const unsigned int sExactIndexRebuildSearches = 64;
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Combine a reference number and an mpNum into a key for the index of mMergedRefs
+    */
+    static inline uint64_t getExactKey(unsigned int refNum, unsigned int mpNum)
+    {
+        return (static_cast<uint64_t>(refNum) << 32) | mpNum;
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Index mMergedRefs by reference number and mpNum
+    */
+    void CellStore::updateExactIndex()
+    {
+        mExactIndex.clear();
+        mExactIndex.reserve(mMergedRefs.size());
+
+        for (size_t i = 0; i < mMergedRefs.size(); ++i)
+        {
+            const CellRef& cellRef = mMergedRefs[i]->mRef;
+
+            // Objects without either number are never searched for
+            if (cellRef.getRefNum().mIndex == 0 && cellRef.getMpNum() == 0)
+                continue;
+
+            mExactIndex.emplace(getExactKey(cellRef.getRefNum().mIndex, cellRef.getMpNum()), i);
+        }
+
+        mExactIndexUpToDate = true;
+        mExactIndexStaleSearches = 0;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     /*
         Start of tes3mp addition
 
@@ -644,9 +718,69 @@ namespace MWWorld
         if (refNum == 0 && mpNum == 0)
             return 0;
 
-        SearchExactVisitor searchVisitor(refNum, mpNum, refId, actorsOnly);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+        if (mState != State_Loaded || mMergedRefs.empty())
+            return Ptr();
+
+        mHasState = true;
+
+        const unsigned int numberChanges = CellRef::getNumberChanges();
+
+        if (mExactIndexNumberChanges != numberChanges)
+        {
+            mExactIndexUpToDate = false;
+            mExactIndexNumberChanges = numberChanges;
+            mExactIndexStaleSearches = 0;
+        }
+
+        if (!mExactIndexUpToDate)
+        {
+            if (mExactIndexStaleSearches < sExactIndexRebuildSearches)
+            {
+                mExactIndexStaleSearches++;
+
+                SearchExactVisitor searchVisitor(refNum, mpNum, refId, actorsOnly);
+                forEach(searchVisitor);
+                return searchVisitor.mFound;
+            }
+
+            updateExactIndex();
+        }
+
+        // Several references can share the same numbers, so pick the first of the matching ones in mMergedRefs,
+        // like going through all of them in order would
+        size_t foundPosition = mMergedRefs.size();
+        auto range = mExactIndex.equal_range(getExactKey(refNum, mpNum));
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const size_t position = it->second;
+
+            if (position >= foundPosition)
+                continue;
+
+            LiveCellRefBase* base = mMergedRefs[position];
+
+            if (base->mRef.getRefNum().mIndex != refNum || base->mRef.getMpNum() != mpNum)
+                continue;
+
+            if (!isAccessible(base->mData, base->mRef))
+                continue;
+
+            Ptr ptr(base, this);
+
+            if (actorsOnly && !ptr.getClass().isActor())
+                continue;
+
+            if (!refId.empty() && !Misc::StringUtils::ciEqual(base->mRef.getRefId(), refId))
+                continue;
+
+            foundPosition = position;
+        }
+
+        if (foundPosition == mMergedRefs.size())
+            return Ptr();
+
+        return Ptr(mMergedRefs[foundPosition], this);
     }
     /*
         End of tes3mp addition
@@ -7,6 +7,7 @@
 #include <typeinfo>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "livecellref.hpp"
 #include "cellreflist.hpp"
@@ -110,6 +111,26 @@ namespace MWWorld
             // Merged list of ref's currently in this cell - i.e. with added refs from mMovedHere, removed refs from mMovedToAnotherCell
             std::vector<LiveCellRefBase*> mMergedRefs;
 
+            /*
+                Start of tes3mp addition
+
+                Positions in mMergedRefs of the references with each combination of reference number
+                and mpNum, so objects in packets can be found without going through the whole cell
+
+                After mMergedRefs is repopulated or the numbers of any reference change, searches go through
+                the whole cell again until there have been enough of them to make rebuilding the index worth
+                it, and what the index finds is always checked against the reference's current numbers
+            */
+            std::unordered_multimap<uint64_t, size_t> mExactIndex;
+            bool mExactIndexUpToDate;
+            unsigned int mExactIndexNumberChanges;
+            unsigned int mExactIndexStaleSearches;
+
+            void updateExactIndex();
+            /*
+                End of tes3mp addition
+            */
+
             // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
             Ptr getCurrentPtr(MWWorld::LiveCellRefBase* ref);
 
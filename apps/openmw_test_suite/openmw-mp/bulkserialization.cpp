@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/Packets/Worldstate/PacketWorldMap.hpp>
+
+#include <BitStream.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    // Writes a bool first, so the values after it start in the middle of a byte
+    template<class T>
+    struct ArrayPacket : BasePacket
+    {
+        bool isBulk = true;
+        bool flag = true;
+        std::vector<T> values;
+
+        ArrayPacket() : BasePacket(nullptr) {}
+
+        void Packet(RakNet::BitStream *newBitstream, bool send) override
+        {
+            BasePacket::Packet(newBitstream, send);
+
+            RW(flag, send);
+
+            uint32_t count;
+
+            if (send)
+                count = static_cast<uint32_t>(values.size());
+
+            RW(count, send);
+
+            if (!send)
+                values.resize(count);
+
+            if (isBulk)
+                RW(values.data(), count, send);
+            else
+            {
+                for (auto &&value : values)
+                    RW(value, send);
+            }
+        }
+    };
+
+    struct MwmpBulkSerializationTest : Test
+    {
+        RakNet::BitStream mSendStream;
+
+        template<class Packet>
+        BasePacket::SerializedPacket serialize(Packet &packet)
+        {
+            packet.SetSendStream(&mSendStream);
+            return packet.Serialize();
+        }
+
+        template<class Packet>
+        void read(const BasePacket::SerializedPacket &data, Packet &packet)
+        {
+            RakNet::BitStream readStream(const_cast<unsigned char *>(data->data()),
+                static_cast<unsigned int>(data->size()), false);
+            readStream.IgnoreBytes(BasePacket::headerSize());
+
+            packet.SetReadStream(&readStream);
+            packet.Read();
+        }
+    };
+
+    TEST_F(MwmpBulkSerializationTest, bulk_bytes_should_match_writing_them_one_by_one)
+    {
+        ArrayPacket<char> bulk;
+        ArrayPacket<char> single;
+        single.isBulk = false;
+
+        for (int i = 0; i < 300; i++)
+            bulk.values.push_back(static_cast<char>(i * 7));
+
+        single.values = bulk.values;
+
+        EXPECT_EQ(*serialize(bulk), *serialize(single));
+    }
+
+    TEST_F(MwmpBulkSerializationTest, bulk_values_should_match_writing_them_one_by_one)
+    {
+        ArrayPacket<uint32_t> bulk;
+        ArrayPacket<uint32_t> single;
+        single.isBulk = false;
+
+        for (uint32_t i = 0; i < 100; i++)
+            bulk.values.push_back(i * 0x01020304u);
+
+        single.values = bulk.values;
+
+        EXPECT_EQ(*serialize(bulk), *serialize(single));
+    }
+
+    TEST_F(MwmpBulkSerializationTest, bulk_values_should_round_trip)
+    {
+        ArrayPacket<float> sent;
+
+        for (int i = 0; i < 100; i++)
+            sent.values.push_back(i * 0.5f);
+
+        ArrayPacket<float> received;
+        read(serialize(sent), received);
+
+        EXPECT_TRUE(received.isPacketValid());
+        EXPECT_TRUE(received.flag);
+        EXPECT_EQ(received.values, sent.values);
+    }
+
+    TEST_F(MwmpBulkSerializationTest, world_map_tiles_should_round_trip)
+    {
+        BaseWorldstate sentWorldstate;
+
+        for (int i = 0; i < 4; i++)
+        {
+            MapTile mapTile;
+            mapTile.x = i - 2;
+            mapTile.y = i * 3;
+
+            for (int j = 0; j < maxImageDataSize - i * 100; j++)
+                mapTile.imageData.push_back(static_cast<char>(j * 31 + i));
+
+            sentWorldstate.mapTiles.push_back(mapTile);
+        }
+
+        PacketWorldMap sender(nullptr);
+        sender.setWorldstate(&sentWorldstate);
+
+        BaseWorldstate receivedWorldstate;
+        PacketWorldMap receiver(nullptr);
+        receiver.setWorldstate(&receivedWorldstate);
+
+        read(serialize(sender), receiver);
+
+        ASSERT_EQ(receivedWorldstate.mapTiles.size(), sentWorldstate.mapTiles.size());
+
+        for (size_t i = 0; i < sentWorldstate.mapTiles.size(); i++)
+        {
+            EXPECT_EQ(receivedWorldstate.mapTiles[i].x, sentWorldstate.mapTiles[i].x);
+            EXPECT_EQ(receivedWorldstate.mapTiles[i].y, sentWorldstate.mapTiles[i].y);
+            EXPECT_EQ(receivedWorldstate.mapTiles[i].imageData, sentWorldstate.mapTiles[i].imageData);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/CellIndex.hpp>
+
+namespace
+{
+    using namespace testing;
+
+    struct MwmpCellIndexTest : Test
+    {
+        CellIndex<int> mIndex;
+        int mFirst = 1;
+        int mSecond = 2;
+
+        static ESM::Cell makeInterior(const std::string &name)
+        {
+            ESM::Cell cell;
+            cell.mData.mFlags |= ESM::Cell::Interior;
+            cell.mName = name;
+            return cell;
+        }
+
+        static ESM::Cell makeExterior(int x, int y)
+        {
+            ESM::Cell cell;
+            cell.mData.mX = x;
+            cell.mData.mY = y;
+            return cell;
+        }
+    };
+
+    TEST_F(MwmpCellIndexTest, interiors_should_be_found_regardless_of_case)
+    {
+        mIndex.add(makeInterior("Seyda Neen, Census and Excise Office"), &mFirst);
+
+        EXPECT_EQ(mIndex.get(makeInterior("seyda neen, census and excise office")), &mFirst);
+        EXPECT_EQ(mIndex.getInterior("SEYDA NEEN, CENSUS AND EXCISE OFFICE"), &mFirst);
+
+        mIndex.remove(makeInterior("seyda neen, Census and Excise Office"), &mFirst);
+
+        EXPECT_EQ(mIndex.getInterior("Seyda Neen, Census and Excise Office"), nullptr);
+    }
+
+    TEST_F(MwmpCellIndexTest, missing_cells_should_not_be_found)
+    {
+        mIndex.add(makeExterior(-2, 6), &mFirst);
+
+        EXPECT_EQ(mIndex.getExterior(-2, 6), &mFirst);
+        EXPECT_EQ(mIndex.getExterior(6, -2), nullptr);
+        EXPECT_EQ(mIndex.get(makeInterior("Balmora")), nullptr);
+    }
+
+    TEST_F(MwmpCellIndexTest, remove_should_leave_entries_for_other_cells)
+    {
+        mIndex.add(makeInterior("Balmora, Guild of Mages"), &mFirst);
+        mIndex.add(makeInterior("balmora, guild of mages"), &mSecond);
+
+        mIndex.remove(makeInterior("Balmora, Guild of Mages"), &mFirst);
+
+        EXPECT_EQ(mIndex.getInterior("Balmora, Guild of Mages"), &mSecond);
+    }
+}
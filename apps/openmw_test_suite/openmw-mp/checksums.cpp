@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <components/openmw-mp/ChecksumCache.hpp>
+#include <components/openmw-mp/Utils.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpChecksumsTest : Test
+    {
+        boost::filesystem::path mDirectory;
+
+        MwmpChecksumsTest()
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            boost::filesystem::create_directories(mDirectory);
+        }
+
+        ~MwmpChecksumsTest()
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove_all(mDirectory, error);
+        }
+
+        std::string writeFile(const std::string &name, const std::string &data)
+        {
+            boost::filesystem::path path = mDirectory / name;
+            boost::filesystem::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream << data;
+            return path.string();
+        }
+
+        static unsigned int boostChecksum(const std::string &data)
+        {
+            boost::crc_32_type crc;
+            crc.process_bytes(data.data(), data.size());
+            return crc.checksum();
+        }
+    };
+
+    TEST_F(MwmpChecksumsTest, crc32_should_match_boost_for_any_length_and_alignment)
+    {
+        std::string data;
+        for (int i = 0; i < 300; i++)
+            data += static_cast<char>(i * 31 + 7);
+
+        for (size_t offset = 0; offset < 8; offset++)
+        {
+            for (size_t length = 0; length + offset <= data.size(); length += 13)
+            {
+                std::string part = data.substr(offset, length);
+                EXPECT_EQ(Utils::crc32(0, part.data(), part.size()), boostChecksum(part)) << offset << " " << length;
+            }
+        }
+    }
+
+    TEST_F(MwmpChecksumsTest, crc32_should_continue_from_previous_checksum)
+    {
+        const std::string data = "The quick brown fox jumps over the lazy dog";
+        unsigned int checksum = Utils::crc32(0, data.data(), 10);
+        checksum = Utils::crc32(checksum, data.data() + 10, data.size() - 10);
+
+        EXPECT_EQ(checksum, 0x414FA339u);
+    }
+
+    TEST_F(MwmpChecksumsTest, file_checksum_should_cover_data_larger_than_read_buffer)
+    {
+        std::string data(3 * 1024 * 1024 + 123, '\0');
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = static_cast<char>(i ^ (i >> 9));
+
+        EXPECT_EQ(Utils::crc32Checksum(writeFile("large.esm", data)), boostChecksum(data));
+    }
+
+    TEST_F(MwmpChecksumsTest, cache_should_return_checksums_in_order_of_files)
+    {
+        std::vector<std::string> files {writeFile("a.esm", "first"), writeFile("b.esp", "second"),
+            writeFile("c.esp", "third")};
+
+        ChecksumCache cache((mDirectory / "cache.txt").string());
+        std::vector<unsigned int> checksums = cache.getChecksums(files);
+
+        ASSERT_EQ(checksums.size(), 3u);
+        EXPECT_EQ(checksums[0], boostChecksum("first"));
+        EXPECT_EQ(checksums[1], boostChecksum("second"));
+        EXPECT_EQ(checksums[2], boostChecksum("third"));
+    }
+
+    TEST_F(MwmpChecksumsTest, cache_should_be_read_back_from_disk_while_file_is_unchanged)
+    {
+        std::string file = writeFile("a.esm", "content");
+        std::string cachePath = (mDirectory / "cache.txt").string();
+
+        ChecksumCache(cachePath).getChecksums({file});
+
+        // Only the cache file can make the checksum come out as this
+        std::string cacheData;
+        {
+            boost::filesystem::ifstream stream(boost::filesystem::path(cachePath), std::ios::binary);
+            std::getline(stream, cacheData, '\0');
+        }
+
+        char checksum[16];
+        snprintf(checksum, sizeof(checksum), "%x", boostChecksum("content"));
+        size_t position = cacheData.find(checksum);
+        ASSERT_NE(position, std::string::npos);
+        cacheData.replace(position, strlen(checksum), "1234abcd");
+        writeFile("cache.txt", cacheData);
+
+        EXPECT_EQ(ChecksumCache(cachePath).getChecksums({file})[0], 0x1234abcdu);
+    }
+
+    TEST_F(MwmpChecksumsTest, cache_should_read_file_again_once_its_size_changes)
+    {
+        std::string file = writeFile("a.esm", "content");
+        ChecksumCache cache((mDirectory / "cache.txt").string());
+
+        EXPECT_EQ(cache.getChecksums({file})[0], boostChecksum("content"));
+
+        writeFile("a.esm", "longer content");
+        EXPECT_EQ(cache.getChecksums({file})[0], boostChecksum("longer content"));
+    }
+}
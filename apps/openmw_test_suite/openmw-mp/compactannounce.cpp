@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/Master/CompactAnnounceState.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    // Answers announcements the way masters from before the compact encoding do
+    struct OldMaster
+    {
+        bool isKnown;
+        // Whether the master took in the server's data from an announcement
+        bool isUpdated;
+
+        explicit OldMaster(bool isKnown) : isKnown(isKnown), isUpdated(false)
+        {
+
+        }
+
+        uint32_t answer(uint32_t func)
+        {
+            // Server data only follows FUNCTION_ANNOUNCE as far as these masters know
+            if (func == PacketMasterAnnounce::FUNCTION_ANNOUNCE)
+            {
+                isKnown = true;
+                isUpdated = true;
+                return PacketMasterAnnounce::FUNCTION_KEEP;
+            }
+
+            if (isKnown && func != PacketMasterAnnounce::FUNCTION_DELETE)
+                return PacketMasterAnnounce::FUNCTION_KEEP;
+
+            return PacketMasterAnnounce::FUNCTION_DELETE;
+        }
+    };
+
+    struct MwmpCompactAnnounceTest : Test
+    {
+        CompactAnnounceState mState;
+    };
+
+    TEST_F(MwmpCompactAnnounceTest, should_announce_compact_until_master_answers)
+    {
+        EXPECT_EQ(mState.GetAnnounceFunc(), PacketMasterAnnounce::FUNCTION_ANNOUNCE_COMPACT);
+        EXPECT_FALSE(mState.IsSettled());
+        EXPECT_FALSE(mState.IsConfirmed());
+    }
+
+    TEST_F(MwmpCompactAnnounceTest, should_confirm_compact_only_on_compact_keepalive)
+    {
+        EXPECT_FALSE(mState.OnReply(PacketMasterAnnounce::FUNCTION_KEEP_COMPACT));
+
+        EXPECT_TRUE(mState.IsConfirmed());
+        EXPECT_TRUE(mState.IsSettled());
+        EXPECT_EQ(mState.GetAnnounceFunc(), PacketMasterAnnounce::FUNCTION_ANNOUNCE_COMPACT);
+
+        // Keepalives after that are answered with FUNCTION_KEEP, which must not undo the confirmation
+        EXPECT_FALSE(mState.OnReply(PacketMasterAnnounce::FUNCTION_KEEP));
+        EXPECT_EQ(mState.GetAnnounceFunc(), PacketMasterAnnounce::FUNCTION_ANNOUNCE_COMPACT);
+    }
+
+    TEST_F(MwmpCompactAnnounceTest, old_master_listing_server_should_get_announcement_the_older_way)
+    {
+        OldMaster master(true);
+
+        EXPECT_TRUE(mState.OnReply(master.answer(mState.GetAnnounceFunc())));
+        EXPECT_FALSE(mState.IsConfirmed());
+        EXPECT_FALSE(master.isUpdated);
+
+        EXPECT_EQ(mState.GetAnnounceFunc(), PacketMasterAnnounce::FUNCTION_ANNOUNCE);
+        EXPECT_FALSE(mState.OnReply(master.answer(mState.GetAnnounceFunc())));
+        EXPECT_TRUE(master.isUpdated);
+
+        EXPECT_TRUE(mState.IsSettled());
+        EXPECT_FALSE(mState.IsConfirmed());
+        EXPECT_EQ(mState.GetAnnounceFunc(), PacketMasterAnnounce::FUNCTION_ANNOUNCE);
+    }
+
+    TEST_F(MwmpCompactAnnounceTest, old_master_without_server_should_get_announcement_the_older_way)
+    {
+        OldMaster master(false);
+
+        EXPECT_TRUE(mState.OnReply(master.answer(mState.GetAnnounceFunc())));
+        EXPECT_FALSE(master.isKnown);
+
+        EXPECT_FALSE(mState.OnReply(master.answer(mState.GetAnnounceFunc())));
+        EXPECT_TRUE(master.isKnown);
+        EXPECT_TRUE(master.isUpdated);
+        EXPECT_FALSE(mState.IsConfirmed());
+    }
+}
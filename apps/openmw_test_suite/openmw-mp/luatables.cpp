@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/Packets/Object/PacketContainer.hpp>
+
+#include <apps/openmw-mp/Script/LangLua/LuaTableFields.hpp>
+
+#include <BitStream.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpLuaTablesTest : Test
+    {
+        lua_State *mLua;
+        RakNet::BitStream mSendStream;
+
+        MwmpLuaTablesTest() : mLua(luaL_newstate())
+        {
+
+        }
+
+        ~MwmpLuaTablesTest()
+        {
+            lua_close(mLua);
+        }
+
+        static ContainerItem makeItem(const std::string &refId, int count, int charge, const std::string &soul)
+        {
+            ContainerItem item = {};
+            item.refId = refId;
+            item.count = count;
+            item.charge = charge;
+            item.enchantmentCharge = -1;
+            item.soul = soul;
+            item.actionCount = count;
+            return item;
+        }
+
+        // Send an object list through a container packet and return the list the other side reads from it
+        BaseObjectList sendContainer(BaseObjectList &objectList)
+        {
+            objectList.packetOrigin = SERVER_SCRIPT;
+            objectList.action = BaseObjectList::SET;
+            objectList.containerSubAction = BaseObjectList::REPLY_TO_REQUEST;
+            objectList.cell.blank();
+
+            PacketContainer sender(nullptr);
+            sender.setObjectList(&objectList);
+            sender.SetSendStream(&mSendStream);
+            BasePacket::SerializedPacket data = sender.Serialize();
+
+            BaseObjectList receivedList;
+            PacketContainer receiver(nullptr);
+            receiver.setObjectList(&receivedList);
+
+            RakNet::BitStream readStream(const_cast<unsigned char *>(data->data()),
+                static_cast<unsigned int>(data->size()), false);
+            readStream.IgnoreBytes(BasePacket::headerSize());
+
+            receiver.SetReadStream(&readStream);
+            receiver.Read();
+            return receivedList;
+        }
+
+        BaseObject roundTrip(const BaseObject &object)
+        {
+            LuaTableFields::pushObject(mLua, object);
+
+            BaseObject result = {};
+            LuaTableFields::readObject(mLua, result);
+
+            lua_pop(mLua, 1);
+            return result;
+        }
+    };
+
+    TEST_F(MwmpLuaTablesTest, container_packet_should_round_trip_through_table)
+    {
+        BaseObject chest = {};
+        chest.refId = "chest_small_01";
+        chest.refNum = 4321;
+        chest.mpNum = 0;
+        chest.containerItems.push_back(makeItem("gold_001", 250, -1, ""));
+        chest.containerItems.push_back(makeItem("misc_soulgem_petty", 2, -1, "mudcrab"));
+        chest.containerItems.push_back(makeItem("iron dagger", 1, 400, ""));
+
+        BaseObjectList objectList;
+        objectList.baseObjects.push_back(chest);
+
+        BaseObjectList receivedList = sendContainer(objectList);
+
+        ASSERT_TRUE(receivedList.isValid);
+        ASSERT_EQ(receivedList.baseObjects.size(), 1u);
+
+        // Container packets never read hasContainer, so it can't be what decides whether items are listed
+        receivedList.baseObjects[0].hasContainer = false;
+
+        BaseObject result = roundTrip(receivedList.baseObjects[0]);
+
+        EXPECT_EQ(result.refId, chest.refId);
+        EXPECT_EQ(result.refNum, chest.refNum);
+        EXPECT_EQ(result.mpNum, chest.mpNum);
+        EXPECT_EQ(result.containerItemCount, 3u);
+        ASSERT_EQ(result.containerItems.size(), chest.containerItems.size());
+
+        for (size_t i = 0; i < chest.containerItems.size(); i++)
+        {
+            EXPECT_EQ(result.containerItems[i].refId, chest.containerItems[i].refId);
+            EXPECT_EQ(result.containerItems[i].count, chest.containerItems[i].count);
+            EXPECT_EQ(result.containerItems[i].charge, chest.containerItems[i].charge);
+            EXPECT_EQ(result.containerItems[i].enchantmentCharge, chest.containerItems[i].enchantmentCharge);
+            EXPECT_EQ(result.containerItems[i].soul, chest.containerItems[i].soul);
+            EXPECT_EQ(result.containerItems[i].actionCount, chest.containerItems[i].actionCount);
+        }
+    }
+
+    TEST_F(MwmpLuaTablesTest, object_without_items_should_have_no_container_items)
+    {
+        BaseObject object = {};
+        object.refId = "chest_small_01";
+        object.hasContainer = true;
+
+        LuaTableFields::pushObject(mLua, object);
+        lua_getfield(mLua, -1, "containerItems");
+
+        EXPECT_TRUE(lua_isnil(mLua, -1));
+
+        lua_pop(mLua, 2);
+    }
+
+    TEST_F(MwmpLuaTablesTest, dialogue_and_summon_fields_should_round_trip_through_table)
+    {
+        BaseObject object = {};
+        object.refId = "scamp";
+        object.dialogueChoiceType = 3;
+        object.topicId = "latest rumors";
+        object.goldPool = 120;
+        object.lastGoldRestockHour = 13.5f;
+        object.lastGoldRestockDay = 42;
+        object.isSummon = true;
+        object.summonEffectId = 102;
+        object.summonSpellId = "summon scamp";
+        object.summonDuration = 60.0f;
+        object.master.refId = "fargoth";
+        object.master.refNum = 17;
+        object.master.mpNum = 5;
+
+        BaseObject result = roundTrip(object);
+
+        EXPECT_EQ(result.dialogueChoiceType, object.dialogueChoiceType);
+        EXPECT_EQ(result.topicId, object.topicId);
+        EXPECT_EQ(result.goldPool, object.goldPool);
+        EXPECT_EQ(result.lastGoldRestockHour, object.lastGoldRestockHour);
+        EXPECT_EQ(result.lastGoldRestockDay, object.lastGoldRestockDay);
+        EXPECT_TRUE(result.isSummon);
+        EXPECT_EQ(result.summonEffectId, object.summonEffectId);
+        EXPECT_EQ(result.summonSpellId, object.summonSpellId);
+        EXPECT_EQ(result.summonDuration, object.summonDuration);
+        EXPECT_FALSE(result.master.isPlayer);
+        EXPECT_EQ(result.master.refId, object.master.refId);
+        EXPECT_EQ(result.master.refNum, object.master.refNum);
+        EXPECT_EQ(result.master.mpNum, object.master.mpNum);
+        EXPECT_TRUE(result.containerItems.empty());
+    }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/PacketBatcher.hpp>
+
+#include <RakPeerInterface.h>
+
+#include <deque>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpPacketBatcherTest : Test
+    {
+        RakNet::RakPeerInterface *mPeer;
+        std::vector<unsigned char> mBatchData;
+        std::deque<RakNet::Packet*> mPackets;
+
+        MwmpPacketBatcherTest() : mPeer(RakNet::RakPeerInterface::GetInstance())
+        {
+            mBatchData.push_back(ID_PACKET_BATCH);
+        }
+
+        ~MwmpPacketBatcherTest()
+        {
+            for (RakNet::Packet *packet : mPackets)
+                mPeer->DeallocatePacket(packet);
+
+            RakNet::RakPeerInterface::DestroyInstance(mPeer);
+        }
+
+        // Packets in these tests are short enough for their length to fit in a single byte
+        void addPacket(const std::vector<unsigned char> &data)
+        {
+            mBatchData.push_back(static_cast<unsigned char>(data.size()));
+            mBatchData.insert(mBatchData.end(), data.begin(), data.end());
+        }
+
+        void unpack()
+        {
+            RakNet::Packet batch;
+            batch.data = mBatchData.data();
+            batch.length = static_cast<unsigned int>(mBatchData.size());
+            batch.bitSize = batch.length * 8;
+            batch.guid = RakNet::RakNetGUID(7);
+
+            PacketBatcher::unpack(mPeer, batch, mPackets);
+        }
+    };
+
+    TEST_F(MwmpPacketBatcherTest, should_unpack_every_packet_in_order)
+    {
+        addPacket({ID_PLAYER_POSITION, 1, 2, 3});
+        addPacket({ID_OBJECT_PLACE, 4});
+        unpack();
+
+        ASSERT_EQ(mPackets.size(), 2u);
+        EXPECT_EQ(std::vector<unsigned char>(mPackets[0]->data, mPackets[0]->data + mPackets[0]->length),
+            std::vector<unsigned char>({ID_PLAYER_POSITION, 1, 2, 3}));
+        EXPECT_EQ(std::vector<unsigned char>(mPackets[1]->data, mPackets[1]->data + mPackets[1]->length),
+            std::vector<unsigned char>({ID_OBJECT_PLACE, 4}));
+        EXPECT_EQ(mPackets[1]->guid, RakNet::RakNetGUID(7));
+    }
+
+    TEST_F(MwmpPacketBatcherTest, forged_disconnection_should_end_the_batch)
+    {
+        addPacket({ID_PLAYER_POSITION, 1, 2, 3});
+        addPacket({ID_DISCONNECTION_NOTIFICATION});
+        addPacket({ID_OBJECT_PLACE, 4});
+        unpack();
+
+        ASSERT_EQ(mPackets.size(), 1u);
+        EXPECT_EQ(mPackets[0]->data[0], ID_PLAYER_POSITION);
+    }
+
+    TEST_F(MwmpPacketBatcherTest, nested_batch_should_end_the_batch)
+    {
+        addPacket({ID_PACKET_BATCH, 2, ID_OBJECT_PLACE, 4});
+        addPacket({ID_OBJECT_PLACE, 4});
+        unpack();
+
+        EXPECT_TRUE(mPackets.empty());
+    }
+
+    TEST_F(MwmpPacketBatcherTest, truncated_packet_should_end_the_batch)
+    {
+        addPacket({ID_PLAYER_POSITION, 1, 2, 3});
+        mBatchData.push_back(10);
+        mBatchData.push_back(ID_OBJECT_PLACE);
+        unpack();
+
+        EXPECT_EQ(mPackets.size(), 1u);
+    }
+}
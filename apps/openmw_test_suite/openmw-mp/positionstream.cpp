@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <components/openmw-mp/Base/PositionStream.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpPositionStreamTest : Test
+    {
+        ESM::Position mPosition;
+        ESM::Position mDirection;
+
+        MwmpPositionStreamTest()
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                mPosition.pos[i] = 4096.5f * (i + 1);
+                mPosition.rot[i] = 0.25f * i;
+                mDirection.pos[i] = 0;
+                mDirection.rot[i] = 0;
+            }
+
+            mDirection.pos[1] = 1;
+        }
+
+        void expectNear(const ESM::Position &expected, const ESM::Position &actual)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                EXPECT_NEAR(expected.pos[i], actual.pos[i], 0.5f / PositionStream::positionScale);
+                EXPECT_NEAR(expected.rot[i], actual.rot[i], 0.5f / PositionStream::rotationScale);
+            }
+        }
+    };
+
+    TEST_F(MwmpPositionStreamTest, first_update_should_be_keyframe)
+    {
+        PositionStream sender;
+        PositionUpdate update;
+        sender.encode(mPosition, mDirection, update);
+
+        EXPECT_EQ(update.type, PositionUpdate::KEYFRAME);
+    }
+
+    TEST_F(MwmpPositionStreamTest, deltas_should_only_carry_changed_components)
+    {
+        PositionStream sender;
+        PositionUpdate update;
+        sender.encode(mPosition, mDirection, update);
+
+        mPosition.pos[1] += 10;
+        sender.encode(mPosition, mDirection, update);
+
+        EXPECT_EQ(update.type, PositionUpdate::DELTA);
+        EXPECT_EQ(update.changedMask, 1 << 1);
+        EXPECT_EQ(update.values[1], 10 * PositionStream::positionScale);
+    }
+
+    TEST_F(MwmpPositionStreamTest, receiver_should_follow_sender)
+    {
+        PositionStream sender;
+        PositionStream receiver;
+        PositionUpdate update;
+        ESM::Position position;
+        ESM::Position direction;
+
+        for (int i = 0; i < 100; i++)
+        {
+            mPosition.pos[0] += 3.3f;
+            mPosition.rot[2] = std::fmod(mPosition.rot[2] + 0.05f, 6.28f);
+            sender.encode(mPosition, mDirection, update);
+
+            ASSERT_TRUE(receiver.decode(update, position, direction));
+            expectNear(mPosition, position);
+            EXPECT_EQ(direction.pos[1], 1);
+        }
+    }
+
+    TEST_F(MwmpPositionStreamTest, receiver_should_wait_for_keyframe_after_missed_update)
+    {
+        PositionStream sender;
+        PositionStream receiver;
+        PositionUpdate update;
+        ESM::Position position;
+        ESM::Position direction;
+
+        sender.encode(mPosition, mDirection, update);
+        ASSERT_TRUE(receiver.decode(update, position, direction));
+
+        mPosition.pos[0] += 100;
+        sender.encode(mPosition, mDirection, update);
+
+        mPosition.pos[0] += 100;
+        sender.encode(mPosition, mDirection, update);
+        EXPECT_FALSE(receiver.decode(update, position, direction));
+
+        mPosition.pos[0] += 100;
+        sender.encode(mPosition, mDirection, update);
+        EXPECT_FALSE(receiver.decode(update, position, direction));
+
+        sender.requestKeyframe();
+        sender.encode(mPosition, mDirection, update);
+        EXPECT_EQ(update.type, PositionUpdate::KEYFRAME);
+        ASSERT_TRUE(receiver.decode(update, position, direction));
+        expectNear(mPosition, position);
+    }
+
+    TEST_F(MwmpPositionStreamTest, receiver_joining_late_should_start_at_keyframe)
+    {
+        PositionStream sender;
+        PositionStream receiver;
+        PositionUpdate update;
+        ESM::Position position;
+        ESM::Position direction;
+
+        sender.encode(mPosition, mDirection, update);
+
+        for (unsigned int i = 0; i < PositionStream::keyframeInterval; i++)
+        {
+            mPosition.pos[2] -= 1;
+            sender.encode(mPosition, mDirection, update);
+            EXPECT_EQ(update.type, PositionUpdate::DELTA);
+            EXPECT_FALSE(receiver.decode(update, position, direction));
+        }
+
+        mPosition.pos[2] -= 1;
+        sender.encode(mPosition, mDirection, update);
+        EXPECT_EQ(update.type, PositionUpdate::KEYFRAME);
+        ASSERT_TRUE(receiver.decode(update, position, direction));
+        expectNear(mPosition, position);
+    }
+
+    TEST_F(MwmpPositionStreamTest, not_a_number_should_survive_quantization)
+    {
+        PositionStream sender;
+        PositionStream receiver;
+        PositionUpdate update;
+        ESM::Position position;
+        ESM::Position direction;
+
+        mDirection.rot[0] = std::nanf("");
+        sender.encode(mPosition, mDirection, update);
+        ASSERT_TRUE(receiver.decode(update, position, direction));
+        EXPECT_TRUE(std::isnan(direction.rot[0]));
+
+        mDirection.rot[0] = 0.5f;
+        sender.encode(mPosition, mDirection, update);
+        EXPECT_EQ(update.type, PositionUpdate::DELTA);
+        ASSERT_TRUE(receiver.decode(update, position, direction));
+        EXPECT_EQ(direction.rot[0], 0.5f);
+    }
+
+    TEST_F(MwmpPositionStreamTest, full_updates_should_leave_stream_alone)
+    {
+        PositionStream receiver;
+        PositionUpdate update;
+        ESM::Position position = mPosition;
+        ESM::Position direction = mDirection;
+
+        EXPECT_TRUE(receiver.decode(update, position, direction));
+        EXPECT_EQ(position.pos[0], mPosition.pos[0]);
+
+        update.type = PositionUpdate::DELTA;
+        update.sequence = 1;
+        EXPECT_FALSE(receiver.decode(update, position, direction));
+    }
+}
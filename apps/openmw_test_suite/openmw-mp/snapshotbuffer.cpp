@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include <components/openmw-mp/SnapshotBuffer.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpSnapshotBufferTest : Test
+    {
+        SnapshotBuffer mBuffer;
+        ESM::Position mMoving;
+        ESM::Position mStill;
+
+        MwmpSnapshotBufferTest()
+        {
+            mBuffer.setInterpolationDelay(0.1f);
+            mBuffer.setExtrapolationLimit(0.25f);
+            mBuffer.setSnapDistance(512);
+
+            for (int i = 0; i < 3; i++)
+            {
+                mMoving.pos[i] = 0;
+                mMoving.rot[i] = 0;
+                mStill.pos[i] = 0;
+                mStill.rot[i] = 0;
+            }
+
+            mMoving.pos[1] = 1;
+        }
+
+        static ESM::Position makePosition(float x, float zRotation = 0)
+        {
+            ESM::Position position;
+
+            for (int i = 0; i < 3; i++)
+            {
+                position.pos[i] = 0;
+                position.rot[i] = 0;
+            }
+
+            position.pos[0] = x;
+            position.rot[2] = zRotation;
+            return position;
+        }
+
+        float sampleX(double localTime)
+        {
+            ESM::Position position;
+            ESM::Position direction;
+            EXPECT_TRUE(mBuffer.sample(localTime, position, direction));
+            return position.pos[0];
+        }
+    };
+
+    TEST_F(MwmpSnapshotBufferTest, empty_buffer_should_have_nothing_to_sample)
+    {
+        ESM::Position position;
+        ESM::Position direction;
+
+        EXPECT_TRUE(mBuffer.isEmpty());
+        EXPECT_FALSE(mBuffer.sample(1.0, position, direction));
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_interpolate_behind_newest_position)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.push(10.1, makePosition(10), mMoving);
+
+        EXPECT_NEAR(sampleX(10.15), 5, 0.01f);
+        EXPECT_NEAR(sampleX(10.2), 10, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_space_positions_by_sender_time)
+    {
+        // Sent 50 ms apart, but the second one took 30 ms longer to arrive
+        mBuffer.push(10.0, 1000, makePosition(0), mMoving);
+        mBuffer.push(10.08, 1050, makePosition(10), mMoving);
+
+        // Allowing for the offset between the clocks growing a little in the meantime
+        EXPECT_NEAR(sampleX(10.125), 5, 0.05f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_unwrap_sender_time)
+    {
+        mBuffer.push(10.0, 65526, makePosition(0), mMoving);
+        mBuffer.push(10.02, 14, makePosition(10), mMoving);
+
+        EXPECT_NEAR(sampleX(10.11), 5, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_match_clocks_again_for_sender_with_clock_behind)
+    {
+        mBuffer.push(10.0, 30000, makePosition(0), mMoving);
+        mBuffer.push(10.05, 30050, makePosition(10), mMoving);
+
+        // Another sender takes over, with a clock 25 seconds behind
+        mBuffer.push(10.1, 5000, makePosition(20), mMoving);
+        mBuffer.push(10.15, 5050, makePosition(30), mMoving);
+
+        EXPECT_NEAR(sampleX(10.2), 20, 0.05f);
+        EXPECT_NEAR(sampleX(10.225), 25, 0.05f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, clear_should_forget_sender_clock)
+    {
+        mBuffer.push(10.0, 30000, makePosition(0), mMoving);
+        mBuffer.push(10.05, 30050, makePosition(10), mMoving);
+        mBuffer.clear();
+
+        // Close enough to the first clock that only clearing can tell it apart
+        mBuffer.push(10.1, 30000, makePosition(20), mMoving);
+        mBuffer.push(10.15, 30050, makePosition(30), mMoving);
+
+        EXPECT_NEAR(sampleX(10.225), 25, 0.05f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_sort_positions_arriving_out_of_order)
+    {
+        mBuffer.push(10.0, 1000, makePosition(0), mMoving);
+        mBuffer.push(10.1, 1100, makePosition(20), mMoving);
+        mBuffer.push(10.1, 1050, makePosition(10), mMoving);
+
+        EXPECT_NEAR(sampleX(10.15), 10, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_extrapolate_up_to_limit_while_moving)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.push(10.1, makePosition(10), mMoving);
+
+        EXPECT_NEAR(sampleX(10.3), 20, 0.01f);
+        EXPECT_NEAR(sampleX(11.0), 35, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_not_extrapolate_after_stopping)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.push(10.1, makePosition(10), mStill);
+
+        EXPECT_NEAR(sampleX(10.5), 10, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_correct_extrapolation_errors_over_time)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.push(10.1, makePosition(10), mMoving);
+
+        EXPECT_NEAR(sampleX(10.3), 20, 0.01f);
+
+        // The entity turned out to have stopped where it was last seen
+        mBuffer.push(10.3, makePosition(10), mStill);
+
+        EXPECT_NEAR(sampleX(10.3), 20, 0.01f);
+        EXPECT_NEAR(sampleX(10.4), 15, 0.01f);
+        EXPECT_NEAR(sampleX(11.3), 10, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_snap_to_teleports)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.push(10.1, makePosition(10), mMoving);
+        mBuffer.push(10.2, makePosition(5000), mStill);
+
+        EXPECT_NEAR(sampleX(10.2), 5000, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_interpolate_rotations_the_shorter_way)
+    {
+        const float pi = 3.14159265f;
+        mBuffer.push(10.0, makePosition(0, pi - 0.1f), mStill);
+        mBuffer.push(10.1, makePosition(0, -pi + 0.1f), mStill);
+
+        ESM::Position position;
+        ESM::Position direction;
+        ASSERT_TRUE(mBuffer.sample(10.15, position, direction));
+
+        EXPECT_NEAR(std::abs(position.rot[2]), pi, 0.01f);
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, should_keep_directions_that_are_not_a_number)
+    {
+        ESM::Position direction = mStill;
+        direction.rot[0] = std::numeric_limits<float>::quiet_NaN();
+
+        mBuffer.push(10.0, makePosition(0), direction);
+
+        ESM::Position sampledPosition;
+        ESM::Position sampledDirection;
+        ASSERT_TRUE(mBuffer.sample(10.5, sampledPosition, sampledDirection));
+
+        EXPECT_TRUE(std::isnan(sampledDirection.rot[0]));
+    }
+
+    TEST_F(MwmpSnapshotBufferTest, clear_should_forget_positions)
+    {
+        mBuffer.push(10.0, makePosition(0), mMoving);
+        mBuffer.clear();
+
+        EXPECT_TRUE(mBuffer.isEmpty());
+    }
+}
@@ -4,6 +4,7 @@
 #include <components/esm/loadcell.hpp>
 
 #include <components/openmw-mp/Base/BaseStructs.hpp>
+#include <components/openmw-mp/Base/PositionStream.hpp>
 
 #include <RakNetTypes.h>
 
@@ -25,6 +26,8 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        PositionUpdate positionUpdate;
+        PositionStream positionStream;
 
         ESM::Cell cell;
 
@@ -94,12 +94,12 @@ namespace mwmp
     {
     public:
 
-        BaseObjectList(RakNet::RakNetGUID guid) : guid(guid)
+        BaseObjectList(RakNet::RakNetGUID guid) : guid(guid), hasCell(false)
         {
 
         }
 
-        BaseObjectList()
+        BaseObjectList() : hasCell(false)
         {
 
         }
@@ -128,6 +128,9 @@ namespace mwmp
         unsigned int baseObjectCount;
 
         ESM::Cell cell;
+        // A blank cell reads as the exterior at 0, 0, so lists put together by server scripts
+        // have to remember separately whether a cell was set
+        bool hasCell;
         std::string consoleCommand;
 
         unsigned char packetOrigin; // 0 - Gameplay, 1 - Console, 2 - Client script, 3 - Server script
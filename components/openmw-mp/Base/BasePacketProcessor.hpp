@@ -2,8 +2,8 @@
 #define OPENMW_BASEPACKETPROCESSOR_HPP
 
 #include <string>
+#include <array>
 #include <memory>
-#include <unordered_map>
 #include <stdexcept>
 
 #define BPP_INIT(packet_id) packetID = packet_id; strPacketID = #packet_id; className = typeid(this).name(); avoidReading = false;
@@ -12,7 +12,8 @@ template<typename Proccessor>
 class BasePacketProcessor
 {
 public:
-    typedef std::unordered_map<unsigned char, std::unique_ptr<Proccessor>> processors_t;
+    // Indexed directly by packet ID
+    typedef std::array<std::unique_ptr<Proccessor>, 256> processors_t;
     unsigned char GetPacketID()
     {
         return packetID;
@@ -29,13 +30,23 @@ public:
 
     static void AddProcessor(Proccessor *processor)
     {
-        for (auto &p : processors)
-        {
-            if (processor->packetID == p.first)
-                throw std::logic_error("processor " + p.second->strPacketID + " already registered. Check " +
-                                       processor->className + " and " + p.second->className);
-        }
-        processors.insert(typename processors_t::value_type(processor->GetPacketID(), processor));
+        auto &p = processors[processor->GetPacketID()];
+
+        if (p)
+            throw std::logic_error("processor " + p->strPacketID + " already registered. Check " +
+                                   processor->className + " and " + p->className);
+
+        p.reset(processor);
+    }
+
+    static Proccessor *GetProcessor(unsigned char packetID)
+    {
+        return processors[packetID].get();
+    }
+
+    static bool HasProcessor(unsigned char packetID)
+    {
+        return processors[packetID] != nullptr;
     }
 protected:
     unsigned char packetID;
@@ -10,6 +10,7 @@
 #include <components/esm/loadspel.hpp>
 
 #include <components/openmw-mp/Base/BaseStructs.hpp>
+#include <components/openmw-mp/Base/PositionStream.hpp>
 
 #include <RakNetTypes.h>
 
@@ -238,6 +239,8 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        PositionUpdate positionUpdate;
+        PositionStream positionStream;
         ESM::Position previousCellPosition;
         ESM::Position momentum;
         ESM::Cell cell;
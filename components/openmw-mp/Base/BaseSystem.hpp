@@ -1,6 +1,7 @@
 #ifndef OPENMW_BASESYSTEM_HPP
 #define OPENMW_BASESYSTEM_HPP
 
+#include <cstdint>
 #include <string>
 
 #include <RakNetTypes.h>
@@ -25,6 +26,9 @@ namespace mwmp
         std::string playerName;
         std::string serverPassword;
 
+        // PositionEncoding bits offered by a client, or accepted for it by the server
+        uint8_t positionEncodings = 0;
+
     };
 }
 
@@ -0,0 +1,214 @@
+#ifndef OPENMW_POSITIONSTREAM_HPP
+#define OPENMW_POSITIONSTREAM_HPP
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    // Bits of BaseSystem::positionEncodings, advertised by clients in their handshake and echoed back
+    // by the server with the ones it has accepted for that connection
+    enum PositionEncoding : uint8_t
+    {
+        POSITION_ENCODING_DELTA = 1
+    };
+
+    struct PositionUpdate
+    {
+        enum Type : uint8_t
+        {
+            FULL = 0, // Raw position and direction, with no stream state involved
+            KEYFRAME, // Every quantized component, resetting the receiver's baseline
+            DELTA     // Only the components that changed, relative to the previous update of the stream
+        };
+
+        // Position coordinates and rotations followed by direction coordinates and rotations
+        static const unsigned int componentCount = 12;
+
+        uint8_t type = FULL;
+        uint16_t sequence = 0;
+        // Milliseconds on the sender's clock when the update was encoded, wrapping around, so receivers
+        // can space positions out the way they were sent instead of the way they arrived
+        uint16_t time = 0;
+        uint16_t changedMask = 0;
+        int32_t values[componentCount] = {};
+    };
+
+    /*
+        Tracks one sender's stream of position updates, either on the sending side through encode()
+        or on a receiving side through decode()
+
+        Updates travel over reliable ordered channels, so every update a receiver gets has also been
+        acknowledged in the order it was sent, and the previous update of the stream doubles as the
+        acknowledged state each delta is relative to. Receivers that joined the stream late or missed
+        part of it notice the gap in sequence numbers and ignore deltas until the next keyframe.
+    */
+    class PositionStream
+    {
+    public:
+        // Maximum number of deltas sent between two keyframes
+        static const unsigned int keyframeInterval = 32;
+
+        // Units per world unit, per radian and per unit of movement direction
+        static constexpr float positionScale = 16.0f;
+        static constexpr float rotationScale = 10430.378f; // 65536 / 2pi
+        static constexpr float directionScale = 1024.0f;
+
+        void encode(const ESM::Position &position, const ESM::Position &direction, PositionUpdate &update)
+        {
+            int32_t quantized[PositionUpdate::componentCount];
+            quantize(position, direction, quantized);
+
+            sequence++;
+
+            update.sequence = sequence;
+            update.time = getTime();
+            update.changedMask = 0;
+
+            if (!hasBaseline || updatesSinceKeyframe >= keyframeInterval)
+            {
+                update.type = PositionUpdate::KEYFRAME;
+                updatesSinceKeyframe = 0;
+
+                for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+                    update.values[i] = quantized[i];
+            }
+            else
+            {
+                update.type = PositionUpdate::DELTA;
+                updatesSinceKeyframe++;
+
+                for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+                {
+                    if (quantized[i] != baseline[i])
+                    {
+                        update.changedMask |= 1 << i;
+                        update.values[i] = static_cast<int32_t>(static_cast<uint32_t>(quantized[i]) - static_cast<uint32_t>(baseline[i]));
+                    }
+                    else
+                        update.values[i] = 0;
+                }
+            }
+
+            for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+                baseline[i] = quantized[i];
+
+            hasBaseline = true;
+        }
+
+        // Returns false if the update could not be applied, in which case position and direction are left untouched
+        bool decode(const PositionUpdate &update, ESM::Position &position, ESM::Position &direction)
+        {
+            if (update.type == PositionUpdate::FULL)
+                return true;
+            else if (update.type == PositionUpdate::KEYFRAME)
+            {
+                for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+                    baseline[i] = update.values[i];
+            }
+            else if (update.type == PositionUpdate::DELTA)
+            {
+                if (!hasBaseline || update.sequence != static_cast<uint16_t>(sequence + 1))
+                {
+                    hasBaseline = false;
+                    return false;
+                }
+
+                for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+                {
+                    if (update.changedMask & (1 << i))
+                        baseline[i] = static_cast<int32_t>(static_cast<uint32_t>(baseline[i]) + static_cast<uint32_t>(update.values[i]));
+                }
+            }
+            else
+                return false;
+
+            sequence = update.sequence;
+            hasBaseline = true;
+
+            dequantize(baseline, position, direction);
+            return true;
+        }
+
+        // Make the next encoded update a keyframe, so receivers without a baseline can pick the stream up
+        void requestKeyframe()
+        {
+            updatesSinceKeyframe = keyframeInterval;
+        }
+
+        void reset()
+        {
+            hasBaseline = false;
+            updatesSinceKeyframe = 0;
+        }
+
+        static uint16_t getTime()
+        {
+            auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<uint16_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+        }
+
+        static void quantize(const ESM::Position &position, const ESM::Position &direction,
+            int32_t (&values)[PositionUpdate::componentCount])
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                values[i] = quantize(position.pos[i], positionScale);
+                values[i + 3] = quantize(position.rot[i], rotationScale);
+                values[i + 6] = quantize(direction.pos[i], directionScale);
+                values[i + 9] = quantize(direction.rot[i], directionScale);
+            }
+        }
+
+        static void dequantize(const int32_t (&values)[PositionUpdate::componentCount], ESM::Position &position,
+            ESM::Position &direction)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                position.pos[i] = dequantize(values[i], positionScale);
+                position.rot[i] = dequantize(values[i + 3], rotationScale);
+                direction.pos[i] = dequantize(values[i + 6], directionScale);
+                direction.rot[i] = dequantize(values[i + 9], directionScale);
+            }
+        }
+
+    private:
+        // Not a number is kept as its own value, because actors use it for directions they should not apply
+        static const int32_t nanValue = std::numeric_limits<int32_t>::min();
+        static const int32_t maxValue = std::numeric_limits<int32_t>::max() / 2;
+
+        static int32_t quantize(float value, float scale)
+        {
+            if (std::isnan(value))
+                return nanValue;
+
+            float scaled = std::round(value * scale);
+
+            if (scaled > maxValue)
+                return maxValue;
+            else if (scaled < -maxValue)
+                return -maxValue;
+
+            return static_cast<int32_t>(scaled);
+        }
+
+        static float dequantize(int32_t value, float scale)
+        {
+            if (value == nanValue)
+                return std::numeric_limits<float>::quiet_NaN();
+
+            return value / scale;
+        }
+
+        int32_t baseline[PositionUpdate::componentCount] = {};
+        bool hasBaseline = false;
+        uint16_t sequence = 0;
+        unsigned int updatesSinceKeyframe = 0;
+    };
+}
+
+#endif //OPENMW_POSITIONSTREAM_HPP
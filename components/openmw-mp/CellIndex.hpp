@@ -0,0 +1,84 @@
+#ifndef OPENMW_CELLINDEX_HPP
+#define OPENMW_CELLINDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <components/esm/loadcell.hpp>
+#include <components/misc/stringops.hpp>
+
+/*
+ * Hashed lookup of cells by their exterior coordinates or interior names
+ *
+ * Exteriors are only found by their coordinates and interiors only by their names, which are compared
+ * case-insensitively like Misc::StringUtils::ciEqual() does
+ */
+template <class T>
+class CellIndex
+{
+public:
+    void add(const ESM::Cell &esmCell, T *cell)
+    {
+        if (esmCell.isExterior())
+            exteriors[getExteriorKey(esmCell.mData.mX, esmCell.mData.mY)] = cell;
+        else
+            interiors[Misc::StringUtils::lowerCase(esmCell.mName)] = cell;
+    }
+
+    // Only removes the entry for esmCell if it still points to cell
+    void remove(const ESM::Cell &esmCell, const T *cell)
+    {
+        if (esmCell.isExterior())
+        {
+            auto it = exteriors.find(getExteriorKey(esmCell.mData.mX, esmCell.mData.mY));
+
+            if (it != exteriors.end() && it->second == cell)
+                exteriors.erase(it);
+        }
+        else
+        {
+            auto it = interiors.find(Misc::StringUtils::lowerCase(esmCell.mName));
+
+            if (it != interiors.end() && it->second == cell)
+                interiors.erase(it);
+        }
+    }
+
+    T *getExterior(int x, int y) const
+    {
+        auto it = exteriors.find(getExteriorKey(x, y));
+        return it != exteriors.end() ? it->second : nullptr;
+    }
+
+    T *getInterior(const std::string &name) const
+    {
+        auto it = interiors.find(Misc::StringUtils::lowerCase(name));
+        return it != interiors.end() ? it->second : nullptr;
+    }
+
+    T *get(const ESM::Cell &esmCell) const
+    {
+        if (esmCell.isExterior())
+            return getExterior(esmCell.mData.mX, esmCell.mData.mY);
+        else
+            return getInterior(esmCell.mName);
+    }
+
+    void clear()
+    {
+        exteriors.clear();
+        interiors.clear();
+    }
+
+private:
+    static uint64_t getExteriorKey(int x, int y)
+    {
+        return ((uint64_t) (uint32_t) x << 32) | (uint32_t) y;
+    }
+
+    std::unordered_map<uint64_t, T*> exteriors;
+    // Keyed by lowercase names
+    std::unordered_map<std::string, T*> interiors;
+};
+
+#endif //OPENMW_CELLINDEX_HPP
@@ -0,0 +1,165 @@
+#include "ChecksumCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "TimedLog.hpp"
+#include "Utils.hpp"
+
+using namespace mwmp;
+
+// Raised whenever the format of the cache file changes, so older ones get ignored
+static const int cacheVersion = 1;
+
+ChecksumCache::ChecksumCache(const std::string &cachePath) : cachePath(cachePath), isLoaded(false)
+{
+}
+
+std::vector<unsigned int> ChecksumCache::getChecksums(const std::vector<std::string> &files)
+{
+    if (!isLoaded)
+    {
+        load();
+        isLoaded = true;
+    }
+
+    std::vector<unsigned int> checksums(files.size(), 0);
+    std::vector<Entry> found(files.size());
+    // Files that cannot be looked at still get read, but are not remembered
+    std::vector<bool> isCacheable(files.size(), false);
+    std::vector<size_t> pending;
+
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        boost::system::error_code error;
+        boost::filesystem::path path(files[i]);
+
+        found[i].size = boost::filesystem::file_size(path, error);
+        if (!error)
+            found[i].modified = boost::filesystem::last_write_time(path, error);
+
+        isCacheable[i] = !error;
+        auto it = entries.find(files[i]);
+
+        if (!error && it != entries.end() && it->second.size == found[i].size &&
+            it->second.modified == found[i].modified)
+            checksums[i] = it->second.checksum;
+        else
+            pending.push_back(i);
+    }
+
+    if (pending.empty())
+        return checksums;
+
+    // Every thread takes the next file nobody has started on yet, so one large file does not hold up the rest
+    std::atomic<size_t> next(0);
+
+    auto work = [&]() {
+        for (size_t index = next++; index < pending.size(); index = next++)
+        {
+            size_t file = pending[index];
+            checksums[file] = Utils::crc32Checksum(files[file]);
+        }
+    };
+
+    size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), pending.size());
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < threadCount; i++)
+        threads.emplace_back(work);
+
+    work();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t file : pending)
+    {
+        if (!isCacheable[file])
+            continue;
+
+        found[file].checksum = checksums[file];
+        entries[files[file]] = found[file];
+    }
+
+    save();
+    return checksums;
+}
+
+void ChecksumCache::load()
+{
+    boost::filesystem::path path(cachePath);
+    boost::filesystem::ifstream stream(path);
+
+    if (!stream)
+        return;
+
+    int version = 0;
+    stream >> version;
+
+    if (version != cacheVersion)
+        return;
+
+    std::string line;
+    std::getline(stream, line);
+
+    // Every line holds the checksum in hex, the size, the modification time and then the path, which can have spaces
+    while (std::getline(stream, line))
+    {
+        std::istringstream fields(line);
+        Entry entry;
+        long long modified;
+
+        if (!(fields >> std::hex >> entry.checksum >> std::dec >> entry.size >> modified))
+            continue;
+
+        entry.modified = (std::time_t) modified;
+
+        std::string file;
+        fields.get();
+        std::getline(fields, file);
+
+        if (!file.empty())
+            entries[file] = entry;
+    }
+}
+
+void ChecksumCache::save() const
+{
+    boost::filesystem::path path(cachePath);
+    boost::filesystem::path temporaryPath(cachePath + ".tmp");
+    boost::system::error_code error;
+
+    if (path.has_parent_path())
+        boost::filesystem::create_directories(path.parent_path(), error);
+
+    {
+        boost::filesystem::ofstream stream(temporaryPath, std::ios::trunc);
+
+        if (!stream)
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not write checksum cache to %s", temporaryPath.string().c_str());
+            return;
+        }
+
+        stream << cacheVersion << "\n";
+
+        for (const auto &entry : entries)
+        {
+            stream << std::hex << entry.second.checksum << std::dec << " " << entry.second.size << " "
+                   << (long long) entry.second.modified << " " << entry.first << "\n";
+        }
+    }
+
+    // Replace the previous cache in one go, so a crash while writing never leaves half a file behind
+    boost::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not write checksum cache to %s: %s", path.string().c_str(),
+            error.message().c_str());
+}
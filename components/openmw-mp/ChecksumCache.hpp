@@ -0,0 +1,43 @@
+#ifndef OPENMW_CHECKSUMCACHE_HPP
+#define OPENMW_CHECKSUMCACHE_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mwmp
+{
+    /*
+        Checksums of data files, kept in a file between runs so the files that have not changed since are not
+        read again
+
+        A file counts as unchanged for as long as its size and modification time stay the same
+    */
+    class ChecksumCache
+    {
+    public:
+        explicit ChecksumCache(const std::string &cachePath);
+
+        // Get the checksums of these files in the same order, reading the ones not cached on several threads
+        std::vector<unsigned int> getChecksums(const std::vector<std::string> &files);
+
+    private:
+        struct Entry
+        {
+            uintmax_t size;
+            std::time_t modified;
+            unsigned int checksum;
+        };
+
+        void load();
+        void save() const;
+
+        std::string cachePath;
+        bool isLoaded;
+        std::unordered_map<std::string, Entry> entries;
+    };
+}
+
+#endif //OPENMW_CHECKSUMCACHE_HPP
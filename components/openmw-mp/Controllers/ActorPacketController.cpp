@@ -21,8 +21,7 @@ template <typename T>
 inline void AddPacket(mwmp::ActorPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::ActorPacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::ActorPacketController::ActorPacketController(RakNet::RakPeerInterface *peer)
@@ -52,16 +51,23 @@ mwmp::ActorPacket *mwmp::ActorPacketController::GetPacket(RakNet::MessageID id)
 
 void mwmp::ActorPacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
-    for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    for (const auto &packet : packets)
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
-bool mwmp::ActorPacketController::ContainsPacket(RakNet::MessageID id)
+void mwmp::ActorPacketController::SetBatcher(PacketBatcher *batcher)
 {
-    for(const auto &packet : packets)
+    for (const auto &packet : packets)
     {
-        if (packet.first == id)
-            return true;
+        if (packet)
+            packet->setBatcher(batcher);
     }
-    return false;
+}
+
+bool mwmp::ActorPacketController::ContainsPacket(RakNet::MessageID id)
+{
+    return packets[(unsigned char)id] != nullptr;
 }
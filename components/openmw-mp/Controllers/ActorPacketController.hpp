@@ -4,7 +4,7 @@
 
 #include <RakPeerInterface.h>
 #include "../Packets/Actor/ActorPacket.hpp"
-#include <unordered_map>
+#include <array>
 #include <memory>
 
 namespace mwmp
@@ -15,10 +15,12 @@ namespace mwmp
         ActorPacketController(RakNet::RakPeerInterface *peer);
         ActorPacket *GetPacket(RakNet::MessageID id);
         void SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        void SetBatcher(PacketBatcher *batcher);
 
         bool ContainsPacket(RakNet::MessageID id);
 
-        typedef std::unordered_map<unsigned char, std::unique_ptr<ActorPacket> > packets_t;
+        // Indexed directly by packet ID
+        typedef std::array<std::unique_ptr<ActorPacket>, 256> packets_t;
     private:
         packets_t packets;
     };
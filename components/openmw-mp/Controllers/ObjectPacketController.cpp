@@ -32,8 +32,7 @@ template <typename T>
 inline void AddPacket(mwmp::ObjectPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::ObjectPacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::ObjectPacketController::ObjectPacketController(RakNet::RakPeerInterface *peer)
@@ -75,16 +74,23 @@ mwmp::ObjectPacket *mwmp::ObjectPacketController::GetPacket(RakNet::MessageID id
 
 void mwmp::ObjectPacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
-    for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    for (const auto &packet : packets)
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
-bool mwmp::ObjectPacketController::ContainsPacket(RakNet::MessageID id)
+void mwmp::ObjectPacketController::SetBatcher(PacketBatcher *batcher)
 {
-    for(const auto &packet : packets)
+    for (const auto &packet : packets)
     {
-        if (packet.first == id)
-            return true;
+        if (packet)
+            packet->setBatcher(batcher);
     }
-    return false;
+}
+
+bool mwmp::ObjectPacketController::ContainsPacket(RakNet::MessageID id)
+{
+    return packets[(unsigned char)id] != nullptr;
 }
@@ -4,7 +4,7 @@
 
 #include <RakPeerInterface.h>
 #include "../Packets/Object/ObjectPacket.hpp"
-#include <unordered_map>
+#include <array>
 #include <memory>
 
 namespace mwmp
@@ -15,10 +15,12 @@ namespace mwmp
         ObjectPacketController(RakNet::RakPeerInterface *peer);
         ObjectPacket *GetPacket(RakNet::MessageID id);
         void SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        void SetBatcher(PacketBatcher *batcher);
 
         bool ContainsPacket(RakNet::MessageID id);
 
-        typedef std::unordered_map<unsigned char, std::unique_ptr<ObjectPacket> > packets_t;
+        // Indexed directly by packet ID
+        typedef std::array<std::unique_ptr<ObjectPacket>, 256> packets_t;
     private:
         packets_t packets;
     };
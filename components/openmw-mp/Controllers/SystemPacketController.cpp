@@ -6,8 +6,7 @@ template <typename T>
 inline void AddPacket(mwmp::SystemPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::SystemPacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::SystemPacketController::SystemPacketController(RakNet::RakPeerInterface *peer)
@@ -23,16 +22,23 @@ mwmp::SystemPacket *mwmp::SystemPacketController::GetPacket(RakNet::MessageID id
 
 void mwmp::SystemPacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
-    for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    for (const auto &packet : packets)
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
-bool mwmp::SystemPacketController::ContainsPacket(RakNet::MessageID id)
+void mwmp::SystemPacketController::SetBatcher(PacketBatcher *batcher)
 {
-    for(const auto &packet : packets)
+    for (const auto &packet : packets)
     {
-        if (packet.first == id)
-            return true;
+        if (packet)
+            packet->setBatcher(batcher);
     }
-    return false;
+}
+
+bool mwmp::SystemPacketController::ContainsPacket(RakNet::MessageID id)
+{
+    return packets[(unsigned char)id] != nullptr;
 }
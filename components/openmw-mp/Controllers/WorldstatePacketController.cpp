@@ -16,8 +16,7 @@ template <typename T>
 inline void AddPacket(mwmp::WorldstatePacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::WorldstatePacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::WorldstatePacketController::WorldstatePacketController(RakNet::RakPeerInterface *peer)
@@ -43,16 +42,23 @@ mwmp::WorldstatePacket *mwmp::WorldstatePacketController::GetPacket(RakNet::Mess
 
 void mwmp::WorldstatePacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
-    for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    for (const auto &packet : packets)
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
-bool mwmp::WorldstatePacketController::ContainsPacket(RakNet::MessageID id)
+void mwmp::WorldstatePacketController::SetBatcher(PacketBatcher *batcher)
 {
-    for(const auto &packet : packets)
+    for (const auto &packet : packets)
     {
-        if (packet.first == id)
-            return true;
+        if (packet)
+            packet->setBatcher(batcher);
     }
-    return false;
+}
+
+bool mwmp::WorldstatePacketController::ContainsPacket(RakNet::MessageID id)
+{
+    return packets[(unsigned char)id] != nullptr;
 }
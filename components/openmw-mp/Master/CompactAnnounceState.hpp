@@ -0,0 +1,72 @@
+#ifndef OPENMW_COMPACTANNOUNCESTATE_HPP
+#define OPENMW_COMPACTANNOUNCESTATE_HPP
+
+#include <atomic>
+#include "PacketMasterAnnounce.hpp"
+
+namespace mwmp
+{
+    /*
+        Works out from the master's replies whether it understands compact announcements
+
+        Masters that do answer them with FUNCTION_KEEP_COMPACT. Older ones only read the function of a compact
+        announcement, so they answer it with FUNCTION_KEEP if they already list the server, or FUNCTION_DELETE
+        if they don't, without having taken in anything from it
+
+        The server keeps announcing itself until the master has answered, because a keepalive's FUNCTION_KEEP
+        could not be told apart from an older master's answer
+    */
+    class CompactAnnounceState
+    {
+    public:
+        CompactAnnounceState() : compact(true), confirmed(false)
+        {
+
+        }
+
+        PacketMasterAnnounce::Func GetAnnounceFunc() const
+        {
+            return compact ? PacketMasterAnnounce::FUNCTION_ANNOUNCE_COMPACT : PacketMasterAnnounce::FUNCTION_ANNOUNCE;
+        }
+
+        // Whether keepalives can be sent instead of announcements
+        bool IsSettled() const
+        {
+            return !compact || confirmed;
+        }
+
+        bool IsConfirmed() const
+        {
+            return confirmed;
+        }
+
+        // Returns true if the reply shows that the master ignored the last announcement, which then has to be
+        // sent again the older way
+        bool OnReply(uint32_t func)
+        {
+            if (func == PacketMasterAnnounce::FUNCTION_KEEP_COMPACT)
+            {
+                confirmed = true;
+                return false;
+            }
+
+            if (!compact || confirmed)
+                return false;
+
+            if (func == PacketMasterAnnounce::FUNCTION_KEEP || func == PacketMasterAnnounce::FUNCTION_DELETE)
+            {
+                compact = false;
+                return true;
+            }
+
+            return false;
+        }
+
+    private:
+        // Replies are handled on the networking thread, while announcements are sent from the master client's
+        std::atomic<bool> compact;
+        std::atomic<bool> confirmed;
+    };
+}
+
+#endif //OPENMW_COMPACTANNOUNCESTATE_HPP
@@ -6,13 +6,16 @@
 #include <vector>
 #include <map>
 #include <list>
+#include <cstdint>
 #include <MessageIdentifiers.h>
+#include <RakNetTypes.h>
 
 enum MASTER_PACKETS
 {
     ID_MASTER_QUERY = ID_USER_PACKET_ENUM,
     ID_MASTER_UPDATE,
-    ID_MASTER_ANNOUNCE
+    ID_MASTER_ANNOUNCE,
+    ID_MASTER_QUERY_DELTA
 };
 
 struct ServerRule
@@ -34,41 +37,45 @@ struct Plugin
     Plugin(std::string name = "", unsigned hash = 0): name(std::move(name)), hash(hash) {};
 };
 
+/*
+    What the master knows about a server
+
+    The fields every server has are kept in members of their own, and rules only holds the extra ones set
+    by scripts, so reading them takes no lookups and copying a server takes few allocations
+*/
 struct QueryData
 {
-    QueryData()
-    {
-        rules["name"].type = ServerRule::Type::string;
-        rules["name"].str = "";
-        rules["version"].type = ServerRule::Type::string;
-        rules["version"].str = "";
-        rules["players"].type = ServerRule::Type::number;
-        rules["players"].val = 0;
-        rules["maxPlayers"].type = ServerRule::Type::number;
-        rules["maxPlayers"].val = 0;
-        rules["gamemode"].type = ServerRule::Type::string;
-        rules["gamemode"].str = "";
-        rules["passw"].type = ServerRule::Type::number;
-        rules["passw"].val = 0;
-    }
-    const char *GetName() const { return rules.at("name").str.c_str(); }
-    void SetName(const char *name) { rules["name"].str = name; }
+    const char *GetName() const { return name.c_str(); }
+    void SetName(const char *value) { name = value; }
 
-    const char *GetVersion() const { return rules.at("version").str.c_str(); }
-    void SetVersion(const char *version) { rules["version"].str = version; }
+    const char *GetVersion() const { return version.c_str(); }
+    void SetVersion(const char *value) { version = value; }
 
-    int GetPlayers() const { return (int) rules.at("players").val; }
-    void SetPlayers(int value) { rules["players"].val = value; }
+    int GetPlayers() const { return playerCount; }
+    void SetPlayers(int value) { playerCount = value; }
 
-    int GetMaxPlayers() const { return (int) rules.at("maxPlayers").val; }
-    void SetMaxPlayers(int value) { rules["maxPlayers"].val = value; }
+    int GetMaxPlayers() const { return maxPlayerCount; }
+    void SetMaxPlayers(int value) { maxPlayerCount = value; }
 
-    const char *GetGameMode() const { return rules.at("gamemode").str.c_str(); }
-    void SetGameMode(const char *str) { rules["gamemode"].str = str; }
+    const char *GetGameMode() const { return gameMode.c_str(); }
+    void SetGameMode(const char *value) { gameMode = value; }
 
-    void SetPassword(int value) { rules["passw"].val = value; };
-    int GetPassword() const { return (int) rules.at("passw").val; }
+    void SetPassword(int value) { password = value != 0; };
+    int GetPassword() const { return password; }
+
+    // Whether a rule is one of those kept in members, under the name used for it by the older encoding
+    static bool IsPredefinedRule(const std::string &key)
+    {
+        return key == "name" || key == "version" || key == "players" || key == "maxPlayers" || key == "gamemode" ||
+            key == "passw";
+    }
 
+    std::string name;
+    std::string version;
+    std::string gameMode;
+    int32_t playerCount = 0;
+    int32_t maxPlayerCount = 0;
+    bool password = false;
 
     std::vector<std::string> players;
     std::map<std::string, ServerRule> rules;
@@ -81,4 +88,76 @@ struct QueryData
     const static int maxStringLength = 256;
 };
 
+// Which servers a query is about
+struct QueryFilter
+{
+    enum PasswordFilter : uint8_t
+    {
+        ANY_PASSWORD = 0,
+        WITHOUT_PASSWORD,
+        WITH_PASSWORD
+    };
+
+    // Only servers with exactly this version, or every version if it is empty
+    std::string version;
+    int32_t minPlayers = 0;
+    bool hideFull = false;
+    PasswordFilter password = ANY_PASSWORD;
+
+    bool Matches(const QueryData &server) const
+    {
+        if (!version.empty() && version != server.GetVersion())
+            return false;
+        if (server.GetPlayers() < minPlayers)
+            return false;
+        if (hideFull && server.GetPlayers() >= server.GetMaxPlayers())
+            return false;
+        if (password == WITHOUT_PASSWORD && server.GetPassword() != 0)
+            return false;
+        if (password == WITH_PASSWORD && server.GetPassword() == 0)
+            return false;
+        return true;
+    }
+};
+
+/*
+    A request for the servers that have changed since a revision of the master's server list
+
+    Servers are listed in the order of their addresses, one page at a time. The first page has no cursor,
+    and every following one starts after the address of the last server on the page before it
+*/
+struct QueryDeltaRequest
+{
+    // The master's list the revision belongs to, which changes whenever the master restarts
+    uint32_t instance = 0;
+    // The revision of the first page of the last complete query, or 0 to get every server, which is also
+    // what to ask for the later pages with once the first one says it is complete
+    uint64_t revision = 0;
+    bool hasCursor = false;
+    RakNet::SystemAddress cursor;
+    uint32_t limit = maxLimit;
+    QueryFilter filter;
+
+    const static uint32_t maxLimit = 500;
+};
+
+struct QueryDeltaResponse
+{
+    uint32_t instance = 0;
+    // What to send as the revision of the next query, once every page has been read
+    uint64_t revision = 0;
+    // Whether the servers listed are all there are, so any others the client knows about should be dropped,
+    // which happens when the client's revision is too old to tell what was removed since then
+    bool isComplete = false;
+    bool hasMore = false;
+    // Where the next page starts, if there is one
+    RakNet::SystemAddress cursor;
+    // Servers removed since the revision, or changed so they no longer match the filter, which are meant
+    // to be dropped before applying the servers that were added or changed
+    std::vector<RakNet::SystemAddress> removed;
+    std::map<RakNet::SystemAddress, QueryData> servers;
+
+    const static uint32_t maxRemoved = 8192;
+};
+
 #endif //NEWMASTERPROTO_MASTERDATA_HPP
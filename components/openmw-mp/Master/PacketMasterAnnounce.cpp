@@ -21,8 +21,8 @@ void PacketMasterAnnounce::Packet(BitStream *newBitstream, bool send)
 
     RW(func, send);
 
-    if (func == FUNCTION_ANNOUNCE)
-        ProxyMasterPacket::addServer(this, *server, send);
+    if (func == FUNCTION_ANNOUNCE || func == FUNCTION_ANNOUNCE_COMPACT)
+        ProxyMasterPacket::addServer(this, *server, send, func == FUNCTION_ANNOUNCE_COMPACT);
 }
 
 void PacketMasterAnnounce::SetServer(QueryData *_server)
@@ -23,8 +23,17 @@ namespace mwmp
         {
             FUNCTION_DELETE = 0,
             FUNCTION_ANNOUNCE,
-            FUNCTION_KEEP
+            FUNCTION_KEEP,
+            // Masters from before the compact encoding only read the function, and answer it like a keepalive
+            FUNCTION_ANNOUNCE_COMPACT,
+            // What masters answer compact announcements with instead of FUNCTION_KEEP, which older ones never send
+            FUNCTION_KEEP_COMPACT
         };
+
+        bool IsAnnounce()
+        {
+            return func == FUNCTION_ANNOUNCE || func == FUNCTION_ANNOUNCE_COMPACT;
+        }
     private:
         QueryData *server;
         uint32_t func;
@@ -8,7 +8,7 @@
 using namespace mwmp;
 using namespace RakNet;
 
-PacketMasterQuery::PacketMasterQuery(RakNet::RakPeerInterface *peer) : BasePacket(peer)
+PacketMasterQuery::PacketMasterQuery(RakNet::RakPeerInterface *peer) : BasePacket(peer), compact(false)
 {
     packetID = ID_MASTER_QUERY;
     orderChannel = CHANNEL_MASTER;
@@ -29,7 +29,6 @@ void PacketMasterQuery::Packet(RakNet::BitStream *newBitstream, bool send)
     if (send)
         serverIt = servers->begin();
 
-    QueryData server;
     std::string addr;
     uint16_t port;
     while (serversCount--)
@@ -38,23 +37,24 @@ void PacketMasterQuery::Packet(RakNet::BitStream *newBitstream, bool send)
         {
             addr = serverIt->first.ToString(false);
             port = serverIt->first.GetPort();
-            server = serverIt->second;
         }
         RW(addr, send);
         RW(port, send);
 
-        ProxyMasterPacket::addServer(this, server, send);
-
         if(addr.empty())
         {
             std::cerr << "Address empty. Aborting PacketMasterQuery::Packet" << std::endl;
             return;
         }
 
+        // Servers are sent and read in place, rather than through a copy of each
         if (send)
+        {
+            ProxyMasterPacket::addServer(this, serverIt->second, send, compact);
             serverIt++;
+        }
         else
-            servers->insert(std::pair<SystemAddress, QueryData>(SystemAddress(addr.c_str(), port), server));
+            ProxyMasterPacket::addServer(this, (*servers)[SystemAddress(addr.c_str(), port)], send);
     }
 
 }
@@ -63,3 +63,8 @@ void PacketMasterQuery::SetServers(std::map<SystemAddress, QueryData> *serverMap
 {
     servers = serverMap;
 }
+
+void PacketMasterQuery::SetCompact(bool isCompact)
+{
+    compact = isCompact;
+}
@@ -16,7 +16,10 @@ namespace mwmp
         void Packet(RakNet::BitStream *newBitstream, bool send) override;
 
         void SetServers(std::map<RakNet::SystemAddress, QueryData> *serverMap);
+        // Send servers with the compact encoding, for clients that asked for it
+        void SetCompact(bool isCompact);
     private:
+        bool compact;
         std::map<RakNet::SystemAddress, QueryData> *servers;
     };
 }
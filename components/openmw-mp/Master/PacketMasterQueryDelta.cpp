@@ -0,0 +1,138 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include "PacketMasterQueryDelta.hpp"
+#include "ProxyMasterPacket.hpp"
+
+using namespace mwmp;
+using namespace RakNet;
+
+PacketMasterQueryDelta::PacketMasterQueryDelta(RakNet::RakPeerInterface *peer) : BasePacket(peer),
+    request(nullptr), response(nullptr)
+{
+    packetID = ID_MASTER_QUERY_DELTA;
+    orderChannel = CHANNEL_MASTER;
+    reliability = RELIABLE_ORDERED;
+}
+
+void PacketMasterQueryDelta::RWAddress(RakNet::SystemAddress &addr, bool send)
+{
+    std::string host;
+    uint16_t port = 0;
+
+    if (send)
+    {
+        host = addr.ToString(false);
+        port = addr.GetPort();
+    }
+
+    RW(host, send, false, QueryData::maxStringLength);
+    RW(port, send);
+
+    if (!send)
+        addr = SystemAddress(host.c_str(), port);
+}
+
+void PacketMasterQueryDelta::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    bs = newBitstream;
+    if (send)
+        bs->Write(packetID);
+
+    // The same packet reads every query, so one bad query must not spoil the ones after it
+    packetValid = true;
+
+    if (request != nullptr)
+    {
+        RW(request->instance, send);
+        RW(request->revision, send);
+        RW(request->hasCursor, send);
+
+        if (request->hasCursor)
+            RWAddress(request->cursor, send);
+
+        RW(request->limit, send);
+        if (request->limit > QueryDeltaRequest::maxLimit)
+            request->limit = QueryDeltaRequest::maxLimit;
+
+        QueryFilter &filter = request->filter;
+        RW(filter.version, send, false, QueryData::maxStringLength);
+        RW(filter.minPlayers, send);
+        RW(filter.hideFull, send);
+
+        uint8_t password = filter.password;
+        RW(password, send);
+        if (!send)
+            filter.password = password <= QueryFilter::WITH_PASSWORD ? (QueryFilter::PasswordFilter) password :
+                QueryFilter::ANY_PASSWORD;
+        return;
+    }
+
+    RW(response->instance, send);
+    RW(response->revision, send);
+    RW(response->isComplete, send);
+    RW(response->hasMore, send);
+
+    if (response->hasMore)
+        RWAddress(response->cursor, send);
+
+    uint32_t removedCount = response->removed.size();
+    RW(removedCount, send);
+
+    if (!send)
+    {
+        if (removedCount > QueryDeltaResponse::maxRemoved)
+        {
+            packetValid = false;
+            return;
+        }
+        response->removed.resize(removedCount);
+    }
+
+    for (auto &addr : response->removed)
+        RWAddress(addr, send);
+
+    uint32_t serversCount = response->servers.size();
+    RW(serversCount, send);
+
+    if (!send)
+    {
+        if (serversCount > QueryDeltaRequest::maxLimit)
+        {
+            packetValid = false;
+            return;
+        }
+        response->servers.clear();
+    }
+
+    auto serverIt = response->servers.begin();
+
+    while (serversCount--)
+    {
+        if (send)
+        {
+            SystemAddress addr = serverIt->first;
+            RWAddress(addr, send);
+            ProxyMasterPacket::addServer(this, serverIt->second, send, true);
+            serverIt++;
+        }
+        else
+        {
+            SystemAddress addr;
+            RWAddress(addr, send);
+            ProxyMasterPacket::addServer(this, response->servers[addr], send);
+        }
+    }
+}
+
+void PacketMasterQueryDelta::SetRequest(QueryDeltaRequest *queryRequest)
+{
+    request = queryRequest;
+    response = nullptr;
+    reliability = RELIABLE_ORDERED;
+}
+
+void PacketMasterQueryDelta::SetResponse(QueryDeltaResponse *queryResponse)
+{
+    request = nullptr;
+    response = queryResponse;
+    reliability = response->hasMore ? RELIABLE_ORDERED : RELIABLE_ORDERED_WITH_ACK_RECEIPT;
+}
@@ -0,0 +1,31 @@
+#ifndef OPENMW_PACKETMASTERQUERYDELTA_HPP
+#define OPENMW_PACKETMASTERQUERYDELTA_HPP
+
+#include "../Packets/BasePacket.hpp"
+#include "MasterData.hpp"
+
+namespace mwmp
+{
+    class ProxyMasterPacket;
+
+    // Sent by clients with a request, and answered by the master with a response using the same packet ID
+    class PacketMasterQueryDelta : public BasePacket
+    {
+        friend class ProxyMasterPacket;
+    public:
+        explicit PacketMasterQueryDelta(RakNet::RakPeerInterface *peer);
+
+        void Packet(RakNet::BitStream *newBitstream, bool send) override;
+
+        void SetRequest(QueryDeltaRequest *queryRequest);
+        // Only the last page of a response asks for a receipt, as the master disconnects clients once it arrives
+        void SetResponse(QueryDeltaResponse *queryResponse);
+    private:
+        void RWAddress(RakNet::SystemAddress &addr, bool send);
+
+        QueryDeltaRequest *request;
+        QueryDeltaResponse *response;
+    };
+}
+
+#endif //OPENMW_PACKETMASTERQUERYDELTA_HPP
@@ -5,7 +5,7 @@
 using namespace mwmp;
 using namespace RakNet;
 
-PacketMasterUpdate::PacketMasterUpdate(RakNet::RakPeerInterface *peer) : BasePacket(peer)
+PacketMasterUpdate::PacketMasterUpdate(RakNet::RakPeerInterface *peer) : BasePacket(peer), compact(false)
 {
     packetID = ID_MASTER_UPDATE;
     orderChannel = CHANNEL_MASTER;
@@ -27,7 +27,7 @@ void PacketMasterUpdate::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!send)
         server->first = SystemAddress(addr.c_str(), port);
 
-    ProxyMasterPacket::addServer(this, server->second, send);
+    ProxyMasterPacket::addServer(this, server->second, send, compact);
 
 }
 
@@ -35,3 +35,8 @@ void PacketMasterUpdate::SetServer(std::pair<RakNet::SystemAddress, QueryData> *
 {
     server = serverPair;
 }
+
+void PacketMasterUpdate::SetCompact(bool isCompact)
+{
+    compact = isCompact;
+}
@@ -16,7 +16,10 @@ namespace mwmp
         void Packet(RakNet::BitStream *newBitstream, bool send) override;
 
         void SetServer(std::pair<RakNet::SystemAddress, QueryData> *serverPair);
+        // Send servers with the compact encoding, for clients that asked for it
+        void SetCompact(bool isCompact);
     private:
+        bool compact;
         std::pair<RakNet::SystemAddress, QueryData> *server;
     };
 }
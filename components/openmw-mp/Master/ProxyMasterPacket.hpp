@@ -7,6 +7,7 @@
 
 #include <components/openmw-mp/Packets/BasePacket.hpp>
 #include "MasterData.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace mwmp
@@ -19,53 +20,44 @@ namespace mwmp
         }
 
     public:
+        /*
+            Servers can be encoded in two ways. The older one sends every field as a rule with its name,
+            while the compact one sends the fields every server has in a fixed order, followed by just the
+            extra rules
+
+            The compact encoding starts with compactMarker where the older one has its number of rules, which
+            is never negative, so reading works out which one was used by itself. Only send the compact one
+            to those that asked for it or are known to understand it
+        */
         template<class Packet>
-        static void addServer(Packet *packet, QueryData &server, bool send)
+        static void addServer(Packet *packet, QueryData &server, bool send, bool compact = false)
         {
-            int32_t rulesSize = server.rules.size();
-            packet->RW(rulesSize, send);
-
-            if (rulesSize > QueryData::maxRules)
-                rulesSize = 0;
+            int32_t rulesSize = 0;
 
-            std::map<std::string, ServerRule>::iterator ruleIt;
             if (send)
-                ruleIt = server.rules.begin();
+                rulesSize = compact ? compactMarker : QueryData::predefinedRules + getUserRulesSize(server);
+            else
+                server.rules.clear();
 
-            while (rulesSize--)
-            {
-                ServerRule *rule = nullptr;
-                std::string key;
-                if (send)
-                {
-                    key = ruleIt->first;
-                    rule = &ruleIt->second;
-                }
-
-                packet->RW(key, send, false, QueryData::maxStringLength);
-                if (!send)
-                {
-                    ruleIt = server.rules.insert(std::pair<std::string, ServerRule>(key, ServerRule())).first;
-                    rule = &ruleIt->second;
-                }
+            packet->RW(rulesSize, send);
 
-                packet->RW(rule->type, send);
+            if (rulesSize == compactMarker)
+                addFields(packet, server, send);
+            else
+                addRules(packet, server, send, rulesSize);
 
-                if (rule->type == ServerRule::Type::string)
-                    packet->RW(rule->str, send, QueryData::maxStringLength);
-                else
-                    packet->RW(rule->val, send);
+            int32_t playersCount = std::min((int32_t) server.players.size(), (int32_t) QueryData::maxPlayers);
 
-                if (send)
-                    ruleIt++;
+            if (rulesSize == compactMarker)
+            {
+                uint8_t count = playersCount;
+                packet->RW(count, send);
+                playersCount = count;
             }
+            else
+                packet->RW(playersCount, send);
 
-            std::vector<std::string>::iterator plIt;
-
-            int32_t playersCount = server.players.size();
-            packet->RW(playersCount, send);
-
-            if (playersCount > QueryData::maxPlayers)
+            if (playersCount > QueryData::maxPlayers || playersCount < 0)
                 playersCount = 0;
 
             if (!send)
@@ -74,14 +66,21 @@ namespace mwmp
                 server.players.resize(playersCount);
             }
 
-            for(auto &&player : server.players)
-                packet->RW(player, send, false, QueryData::maxStringLength);
+            for (int32_t i = 0; i < playersCount; i++)
+                packet->RW(server.players[i], send, false, QueryData::maxStringLength);
 
+            int32_t pluginsCount = std::min((int32_t) server.plugins.size(), (int32_t) QueryData::maxPlugins);
 
-            int32_t pluginsCount = server.plugins.size();
-            packet->RW(pluginsCount, send);
+            if (rulesSize == compactMarker)
+            {
+                uint16_t count = pluginsCount;
+                packet->RW(count, send);
+                pluginsCount = count;
+            }
+            else
+                packet->RW(pluginsCount, send);
 
-            if (pluginsCount > QueryData::maxPlugins)
+            if (pluginsCount > QueryData::maxPlugins || pluginsCount < 0)
                 pluginsCount = 0;
 
             if (!send)
@@ -90,11 +89,151 @@ namespace mwmp
                 server.plugins.resize(pluginsCount);
             }
 
-            for (auto &&plugin : server.plugins)
+            for (int32_t i = 0; i < pluginsCount; i++)
+            {
+                packet->RW(server.plugins[i].name, send, false, QueryData::maxStringLength);
+                packet->RW(server.plugins[i].hash, send);
+            }
+        }
+
+        static const int32_t compactMarker = -1;
+
+    private:
+        static int32_t getUserRulesSize(const QueryData &server)
+        {
+            int32_t size = 0;
+
+            for (const auto &rule : server.rules)
             {
-                packet->RW(plugin.name, send, false, QueryData::maxStringLength);
-                packet->RW(plugin.hash, send);
+                if (!QueryData::IsPredefinedRule(rule.first))
+                    size++;
             }
+
+            return std::min(size, (int32_t) QueryData::maxUserRules);
+        }
+
+        template<class Packet>
+        static void addRule(Packet *packet, std::string &key, ServerRule &rule, bool send)
+        {
+            packet->RW(key, send, false, QueryData::maxStringLength);
+            packet->RW(rule.type, send);
+
+            if (rule.type == ServerRule::Type::string)
+                packet->RW(rule.str, send, true, QueryData::maxStringLength);
+            else
+                packet->RW(rule.val, send);
+        }
+
+        template<class Packet>
+        static void addUserRules(Packet *packet, QueryData &server, bool send, int32_t rulesSize)
+        {
+            if (send)
+            {
+                for (auto it = server.rules.begin(); it != server.rules.end() && rulesSize > 0; ++it)
+                {
+                    if (QueryData::IsPredefinedRule(it->first))
+                        continue;
+
+                    std::string key = it->first;
+                    addRule(packet, key, it->second, send);
+                    rulesSize--;
+                }
+                return;
+            }
+
+            while (rulesSize-- > 0)
+            {
+                std::string key;
+                ServerRule rule;
+                addRule(packet, key, rule, send);
+
+                if (!QueryData::IsPredefinedRule(key))
+                    server.rules[key] = rule;
+            }
+        }
+
+        template<class Packet>
+        static void addFields(Packet *packet, QueryData &server, bool send)
+        {
+            packet->RW(server.name, send, false, QueryData::maxStringLength);
+            packet->RW(server.version, send, false, QueryData::maxStringLength);
+            packet->RW(server.gameMode, send, false, QueryData::maxStringLength);
+            packet->RW(server.playerCount, send, true);
+            packet->RW(server.maxPlayerCount, send, true);
+            packet->RW(server.password, send);
+
+            uint8_t rulesSize = getUserRulesSize(server);
+            packet->RW(rulesSize, send);
+
+            // Only a broken or forged packet has more, so don't let it add rules past the limit
+            if (rulesSize > QueryData::maxUserRules)
+                rulesSize = QueryData::maxUserRules;
+
+            addUserRules(packet, server, send, rulesSize);
+        }
+
+        // The older encoding, where the fields every server has are sent as rules too
+        template<class Packet>
+        static void addRules(Packet *packet, QueryData &server, bool send, int32_t rulesSize)
+        {
+            if (rulesSize > QueryData::maxRules || rulesSize < 0)
+                rulesSize = 0;
+
+            if (!send)
+            {
+                while (rulesSize-- > 0)
+                {
+                    std::string key;
+                    ServerRule rule;
+                    addRule(packet, key, rule, send);
+                    setRule(server, key, rule);
+                }
+                return;
+            }
+
+            ServerRule rule;
+            std::string key;
+
+            auto addString = [&](const char *name, std::string &value) {
+                key = name;
+                rule.type = ServerRule::Type::string;
+                rule.str = value;
+                addRule(packet, key, rule, send);
+            };
+
+            auto addNumber = [&](const char *name, double value) {
+                key = name;
+                rule.type = ServerRule::Type::number;
+                rule.val = value;
+                addRule(packet, key, rule, send);
+            };
+
+            addString("name", server.name);
+            addString("version", server.version);
+            addNumber("players", server.playerCount);
+            addNumber("maxPlayers", server.maxPlayerCount);
+            addString("gamemode", server.gameMode);
+            addNumber("passw", server.password);
+
+            addUserRules(packet, server, send, rulesSize - QueryData::predefinedRules);
+        }
+
+        static void setRule(QueryData &server, const std::string &key, const ServerRule &rule)
+        {
+            if (key == "name")
+                server.name = rule.str;
+            else if (key == "version")
+                server.version = rule.str;
+            else if (key == "gamemode")
+                server.gameMode = rule.str;
+            else if (key == "players")
+                server.playerCount = (int32_t) rule.val;
+            else if (key == "maxPlayers")
+                server.maxPlayerCount = (int32_t) rule.val;
+            else if (key == "passw")
+                server.password = (int) rule.val != 0;
+            else
+                server.rules[key] = rule;
         }
     };
 }
@@ -113,6 +113,7 @@ enum GameMessages
     ID_WORLD_DESTINATION_OVERRIDE,
     ID_ACTOR_SPELLS_ACTIVE,
     ID_PLAYER_COOLDOWNS,
+    ID_PACKET_BATCH,
     ID_PLACEHOLDER
 };
 
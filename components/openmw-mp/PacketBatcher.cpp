@@ -0,0 +1,271 @@
+#include <cstring>
+
+#include <RakPeerInterface.h>
+
+#include "NetworkMessages.hpp"
+#include "PacketBatcher.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    void writeLength(std::vector<unsigned char> &data, uint32_t length)
+    {
+        while (length >= 0x80)
+        {
+            data.push_back(static_cast<unsigned char>(length | 0x80));
+            length >>= 7;
+        }
+
+        data.push_back(static_cast<unsigned char>(length));
+    }
+
+    bool readLength(const unsigned char *data, size_t dataLength, size_t &offset, uint32_t &length)
+    {
+        length = 0;
+
+        for (unsigned int shift = 0; shift < 32 && offset < dataLength; shift += 7)
+        {
+            unsigned char byte = data[offset++];
+            length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    unsigned int getLengthSize(uint32_t length)
+    {
+        unsigned int size = 1;
+
+        for (; length >= 0x80; length >>= 7)
+            size++;
+
+        return size;
+    }
+}
+
+PacketBatcher::PacketBatcher(RakNet::RakPeerInterface *peer) : peer(peer), window(0)
+{
+    std::memset(channelBatches, 0, sizeof(channelBatches));
+    std::memset(channelBroadcasts, 0, sizeof(channelBroadcasts));
+}
+
+void PacketBatcher::setWindow(int milliseconds)
+{
+    if (milliseconds < 0)
+        flush(true);
+
+    window = milliseconds;
+}
+
+bool PacketBatcher::isEnabled() const
+{
+    return window >= 0;
+}
+
+uint32_t PacketBatcher::send(const char *data, unsigned int length, PacketPriority priority,
+    PacketReliability reliability, char orderingChannel, const RakNet::AddressOrGUID &destination, bool broadcast)
+{
+    if (window < 0)
+        return peer->Send(data, (int) length, priority, reliability, orderingChannel, destination, broadcast);
+
+    const BatchKey key = getKey(destination, orderingChannel, broadcast);
+    flushConflicting(key);
+
+    auto it = batches.find(key);
+
+    if (reliability != RELIABLE_ORDERED || priority == IMMEDIATE_PRIORITY || length > maxBatchedLength)
+    {
+        // Packets that are sent on their own still have to come after the ones already batched for the same
+        // destination and channel
+        if (it != batches.end())
+            sendAndErase(it);
+
+        return peer->Send(data, (int) length, priority, reliability, orderingChannel, destination, broadcast);
+    }
+
+    if (it == batches.end())
+    {
+        Batch newBatch;
+        newBatch.destination = destination;
+        newBatch.broadcast = broadcast;
+        newBatch.orderingChannel = orderingChannel;
+        newBatch.priority = LOW_PRIORITY;
+        newBatch.data.reserve(maxBatchLength);
+        newBatch.data.push_back(ID_PACKET_BATCH);
+        newBatch.firstPacketOffset = 0;
+        newBatch.packetCount = 0;
+
+        it = batches.emplace(key, std::move(newBatch)).first;
+        channelBatches[(unsigned char) orderingChannel]++;
+        if (broadcast)
+            channelBroadcasts[(unsigned char) orderingChannel]++;
+    }
+
+    Batch &batch = it->second;
+
+    if (batch.packetCount > 0 && batch.data.size() + getLengthSize(length) + length > maxBatchLength)
+        send(batch);
+
+    if (batch.packetCount == 0)
+        batch.queuedAt = Clock::now();
+
+    writeLength(batch.data, length);
+
+    if (batch.packetCount == 0)
+        batch.firstPacketOffset = batch.data.size();
+
+    batch.data.insert(batch.data.end(), data, data + length);
+    batch.packetCount++;
+
+    if (priority < batch.priority)
+        batch.priority = priority;
+
+    // Nothing has been handed to RakNet yet, so there is no message number to return
+    return 1;
+}
+
+void PacketBatcher::flush(bool force)
+{
+    if (batches.empty())
+        return;
+
+    const Clock::time_point now = Clock::now();
+    const std::chrono::milliseconds windowDuration(window);
+
+    for (auto it = batches.begin(); it != batches.end();)
+    {
+        Batch &batch = it->second;
+
+        if (force || window <= 0 || now - batch.queuedAt >= windowDuration)
+            it = sendAndErase(it);
+        else
+            ++it;
+    }
+}
+
+long PacketBatcher::getTimeUntilFlush() const
+{
+    if (batches.empty())
+        return -1;
+    else if (window <= 0)
+        return 0;
+
+    Clock::time_point nextFlush = Clock::time_point::max();
+
+    for (const auto &batch : batches)
+    {
+        if (batch.second.queuedAt < nextFlush)
+            nextFlush = batch.second.queuedAt;
+    }
+
+    nextFlush += std::chrono::milliseconds(window);
+
+    const Clock::time_point now = Clock::now();
+
+    if (nextFlush <= now)
+        return 0;
+
+    // Round up, so that waiting this long always leaves the batch ready to be sent
+    std::chrono::milliseconds timeUntilFlush = std::chrono::duration_cast<std::chrono::milliseconds>(nextFlush - now);
+    if (now + timeUntilFlush < nextFlush)
+        timeUntilFlush += std::chrono::milliseconds(1);
+
+    return (long) timeUntilFlush.count();
+}
+
+void PacketBatcher::unpack(RakNet::RakPeerInterface *peer, const RakNet::Packet &batch,
+    std::deque<RakNet::Packet*> &packets)
+{
+    size_t offset = 1;
+
+    while (offset < batch.length)
+    {
+        uint32_t length;
+
+        if (!readLength(batch.data, batch.length, offset, length) || length == 0 || length > batch.length - offset)
+            break;
+
+        // Only our own packets can be batched, so anything else in a batch was forged to pass for a message
+        // from RakNet itself, such as a disconnection, or to nest batches
+        const unsigned char packetID = batch.data[offset];
+
+        if (packetID < ID_USER_PACKET_ENUM || packetID == ID_PACKET_BATCH)
+            break;
+
+        RakNet::Packet *packet = peer->AllocatePacket(length);
+        std::memcpy(packet->data, batch.data + offset, length);
+        packet->length = length;
+        packet->bitSize = length * 8;
+        packet->systemAddress = batch.systemAddress;
+        packet->guid = batch.guid;
+        packet->wasGeneratedLocally = false;
+
+        packets.push_back(packet);
+        offset += length;
+    }
+}
+
+PacketBatcher::BatchKey PacketBatcher::getKey(const RakNet::AddressOrGUID &destination, char orderingChannel,
+    bool broadcast)
+{
+    return BatchKey(destination.rakNetGuid, destination.systemAddress, orderingChannel, broadcast);
+}
+
+void PacketBatcher::flushConflicting(const BatchKey &key)
+{
+    const char orderingChannel = std::get<2>(key);
+    const bool broadcast = std::get<3>(key);
+
+    // A broadcast can reach every destination with a batch on its channel, while a packet for a single
+    // destination can only conflict with a broadcast
+    unsigned int conflicting = broadcast ? channelBatches[(unsigned char) orderingChannel] :
+        channelBroadcasts[(unsigned char) orderingChannel];
+
+    if (conflicting == 0)
+        return;
+
+    for (auto it = batches.begin(); it != batches.end();)
+    {
+        Batch &batch = it->second;
+
+        if (batch.orderingChannel == orderingChannel && (broadcast || batch.broadcast) && it->first != key)
+            it = sendAndErase(it);
+        else
+            ++it;
+    }
+}
+
+PacketBatcher::Batches::iterator PacketBatcher::sendAndErase(Batches::iterator it)
+{
+    Batch &batch = it->second;
+    send(batch);
+
+    channelBatches[(unsigned char) batch.orderingChannel]--;
+    if (batch.broadcast)
+        channelBroadcasts[(unsigned char) batch.orderingChannel]--;
+
+    return batches.erase(it);
+}
+
+void PacketBatcher::send(Batch &batch)
+{
+    if (batch.packetCount == 1)
+    {
+        peer->Send(reinterpret_cast<const char *>(batch.data.data() + batch.firstPacketOffset),
+            (int) (batch.data.size() - batch.firstPacketOffset), batch.priority, RELIABLE_ORDERED,
+            batch.orderingChannel, batch.destination, batch.broadcast);
+    }
+    else if (batch.packetCount > 1)
+    {
+        peer->Send(reinterpret_cast<const char *>(batch.data.data()), (int) batch.data.size(), batch.priority,
+            RELIABLE_ORDERED, batch.orderingChannel, batch.destination, batch.broadcast);
+    }
+
+    batch.data.resize(1);
+    batch.packetCount = 0;
+    batch.priority = LOW_PRIORITY;
+}
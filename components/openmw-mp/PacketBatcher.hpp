@@ -0,0 +1,93 @@
+#ifndef OPENMW_PACKETBATCHER_HPP
+#define OPENMW_PACKETBATCHER_HPP
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <RakNetTypes.h>
+#include <PacketPriority.h>
+
+namespace RakNet
+{
+    class RakPeerInterface;
+}
+
+namespace mwmp
+{
+    /*
+        Combines small reliable ordered packets sent to the same destination on the same ordering channel
+        into a single ID_PACKET_BATCH message, which the receiving side splits again through unpack()
+
+        Packets keep their order for every recipient: a broadcast waits in a batch of its own, and the
+        batches it could overlap with on its channel are sent before it, and before any packet that cannot
+        be batched
+    */
+    class PacketBatcher
+    {
+    public:
+        // Packets larger than this are never batched
+        static const unsigned int maxBatchedLength = 512;
+        // Batches get sent once they would grow beyond this, keeping each of them within one datagram
+        static const unsigned int maxBatchLength = 1200;
+
+        explicit PacketBatcher(RakNet::RakPeerInterface *peer);
+
+        // -1 sends every packet on its own, 0 combines the packets sent between two flushes, and higher
+        // values also let batches wait up to that many milliseconds for more packets
+        void setWindow(int milliseconds);
+        bool isEnabled() const;
+
+        // Takes the same arguments as RakPeerInterface::Send()
+        uint32_t send(const char *data, unsigned int length, PacketPriority priority, PacketReliability reliability,
+            char orderingChannel, const RakNet::AddressOrGUID &destination, bool broadcast);
+
+        // Send the batches that have waited for the whole window, or all of them if force is true
+        void flush(bool force = false);
+
+        // Milliseconds until flush() has a batch to send, or -1 if there are none
+        long getTimeUntilFlush() const;
+
+        // Split a batch into separate packets allocated through the peer, to be deallocated like received ones
+        //
+        // Stops at the first packet that is malformed or whose ID could not have been batched by send()
+        static void unpack(RakNet::RakPeerInterface *peer, const RakNet::Packet &batch, std::deque<RakNet::Packet*> &packets);
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Batch
+        {
+            RakNet::AddressOrGUID destination;
+            bool broadcast;
+            char orderingChannel;
+            PacketPriority priority;
+            std::vector<unsigned char> data;
+            // Where the only packet of a batch starts, so it can be sent on its own
+            size_t firstPacketOffset;
+            unsigned int packetCount;
+            Clock::time_point queuedAt;
+        };
+
+        typedef std::tuple<RakNet::RakNetGUID, RakNet::SystemAddress, char, bool> BatchKey;
+        typedef std::map<BatchKey, Batch> Batches;
+
+        static BatchKey getKey(const RakNet::AddressOrGUID &destination, char orderingChannel, bool broadcast);
+
+        // Send the batches that would otherwise end up out of order with a packet for this destination
+        void flushConflicting(const BatchKey &key);
+        Batches::iterator sendAndErase(Batches::iterator it);
+        void send(Batch &batch);
+
+        RakNet::RakPeerInterface *peer;
+        int window;
+        Batches batches;
+        // Pending batches and pending broadcast batches per ordering channel, to skip looking for conflicts
+        unsigned int channelBatches[256];
+        unsigned int channelBroadcasts[256];
+    };
+}
+
+#endif //OPENMW_PACKETBATCHER_HPP
@@ -11,8 +11,17 @@ PacketActorPosition::PacketActorPosition(RakNet::RakPeerInterface *peer) : Actor
 
 void PacketActorPosition::Actor(BaseActor &actor, bool send)
 {
-    RW(actor.position, send, true);
-    RW(actor.direction, send, true);
+    if (!RW(actor.positionUpdate, send))
+    {
+        packetValid = false;
+        return;
+    }
+
+    if (actor.positionUpdate.type == PositionUpdate::FULL)
+    {
+        RW(actor.position, send, true);
+        RW(actor.direction, send, true);
+    }
 
     actor.hasPositionData = true;
 }
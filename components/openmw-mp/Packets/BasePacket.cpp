@@ -1,10 +1,14 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Base/PositionStream.hpp>
+#include <components/openmw-mp/PacketBatcher.hpp>
 #include <PacketPriority.h>
 #include <RakPeer.h>
 #include "BasePacket.hpp"
 
 using namespace mwmp;
 
+BasePacket::SendObserver BasePacket::sendObserver = nullptr;
+
 BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
 {
     packetID = 0;
@@ -12,6 +16,7 @@ BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
     reliability = RELIABLE_ORDERED;
     orderChannel = CHANNEL_SYSTEM;
     this->peer = peer;
+    batcher = nullptr;
 }
 
 void BasePacket::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -49,21 +54,72 @@ uint32_t BasePacket::RequestData(RakNet::RakNetGUID targetGuid)
     bsSend->ResetWritePointer();
     bsSend->Write(packetID);
     bsSend->Write(targetGuid);
-    return peer->Send(bsSend, HIGH_PRIORITY, RELIABLE_ORDERED, orderChannel, targetGuid, false);
+    return SendData(reinterpret_cast<const char *>(bsSend->GetData()), bsSend->GetNumberOfBytesUsed(), HIGH_PRIORITY,
+        RELIABLE_ORDERED, targetGuid, false);
 }
 
 uint32_t BasePacket::Send(RakNet::AddressOrGUID destination)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, destination, false);
+    return SendData(reinterpret_cast<const char *>(bsSend->GetData()), bsSend->GetNumberOfBytesUsed(), priority,
+        reliability, destination, false);
 }
 
 uint32_t BasePacket::Send(bool toOther)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
-    return peer->Send(bsSend, priority, reliability, orderChannel, guid, toOther);
+    return SendData(reinterpret_cast<const char *>(bsSend->GetData()), bsSend->GetNumberOfBytesUsed(), priority,
+        reliability, guid, toOther);
+}
+
+void BasePacket::Send(const std::vector<RakNet::RakNetGUID> &destinations)
+{
+    if (destinations.empty())
+        return;
+
+    SerializedPacket serializedPacket = Serialize();
+
+    for (const auto &destination : destinations)
+        Send(serializedPacket, destination);
+}
+
+uint32_t BasePacket::Send(const SerializedPacket &serializedPacket, RakNet::AddressOrGUID destination)
+{
+    return SendData(reinterpret_cast<const char *>(serializedPacket->data()), (unsigned int) serializedPacket->size(),
+        priority, reliability, destination, false);
+}
+
+uint32_t BasePacket::SendData(const char *data, unsigned int length, PacketPriority sendPriority,
+    PacketReliability sendReliability, RakNet::AddressOrGUID destination, bool broadcast)
+{
+    if (sendObserver != nullptr)
+        sendObserver(data, length, destination, broadcast);
+
+    if (batcher != nullptr)
+        return batcher->send(data, length, sendPriority, sendReliability, orderChannel, destination, broadcast);
+
+    return peer->Send(data, (int) length, sendPriority, sendReliability, orderChannel, destination, broadcast);
+}
+
+void BasePacket::setBatcher(PacketBatcher *newBatcher)
+{
+    batcher = newBatcher;
+}
+
+void BasePacket::setSendObserver(SendObserver observer)
+{
+    sendObserver = observer;
+}
+
+BasePacket::SerializedPacket BasePacket::Serialize()
+{
+    bsSend->ResetWritePointer();
+    Packet(bsSend, true);
+
+    const unsigned char *data = bsSend->GetData();
+    return std::make_shared<const std::vector<unsigned char> >(data, data + bsSend->GetNumberOfBytesUsed());
 }
 
 void BasePacket::Read()
@@ -80,3 +136,41 @@ RakNet::RakNetGUID BasePacket::getGUID()
 {
     return guid;
 }
+
+bool BasePacket::RW(PositionUpdate &update, bool write)
+{
+    if (!RW(update.type, write))
+        return false;
+
+    if (update.type == PositionUpdate::FULL)
+        return true;
+
+    if (update.type != PositionUpdate::KEYFRAME && update.type != PositionUpdate::DELTA)
+        return false;
+
+    if (!RW(update.sequence, write) || !RW(update.time, write))
+        return false;
+
+    if (update.type == PositionUpdate::DELTA && !RW(update.changedMask, write))
+        return false;
+
+    for (unsigned int i = 0; i < PositionUpdate::componentCount; i++)
+    {
+        if (update.type == PositionUpdate::DELTA && !(update.changedMask & (1 << i)))
+        {
+            update.values[i] = 0;
+            continue;
+        }
+
+        // Zigzag the values so that small negative ones also compress to a byte or two
+        uint32_t value = (static_cast<uint32_t>(update.values[i]) << 1) ^ static_cast<uint32_t>(update.values[i] >> 31);
+
+        if (!RW(value, write, true))
+            return false;
+
+        if (!write)
+            update.values[i] = static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+    }
+
+    return true;
+}
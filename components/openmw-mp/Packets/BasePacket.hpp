@@ -2,6 +2,9 @@
 #define OPENMW_BASEPACKET_HPP
 
 #include <string>
+#include <type_traits>
+#include <vector>
+#include <memory>
 #include <RakNetTypes.h>
 #include <BitStream.h>
 #include <PacketPriority.h>
@@ -9,9 +12,15 @@
 
 namespace mwmp
 {
+    struct PositionUpdate;
+    class PacketBatcher;
+
     class BasePacket
     {
     public:
+        // The bytes of a fully serialized packet, shared by every recipient it gets sent to
+        typedef std::shared_ptr<const std::vector<unsigned char> > SerializedPacket;
+
         explicit BasePacket(RakNet::RakPeerInterface *peer);
 
         virtual ~BasePacket() = default;
@@ -21,12 +30,24 @@ namespace mwmp
         virtual uint32_t Send(RakNet::AddressOrGUID destination);
         virtual void Read();
 
+        // Run Packet() a single time and hand the same bytes to RakNet for every destination
+        void Send(const std::vector<RakNet::RakNetGUID> &destinations);
+        uint32_t Send(const SerializedPacket &serializedPacket, RakNet::AddressOrGUID destination);
+        SerializedPacket Serialize();
+
         void setGUID(RakNet::RakNetGUID newGuid);
         RakNet::RakNetGUID getGUID();
 
         void SetReadStream(RakNet::BitStream *bitStream);
         void SetSendStream(RakNet::BitStream *bitStream);
         void SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        // Hand packets to a batcher instead of sending them right away
+        void setBatcher(PacketBatcher *newBatcher);
+
+        // Called for every packet about to be sent, from whichever thread sends it
+        typedef void (*SendObserver)(const char *data, unsigned int length, const RakNet::AddressOrGUID &destination,
+            bool broadcast);
+        static void setSendObserver(SendObserver observer);
         virtual uint32_t RequestData(RakNet::RakNetGUID targetGuid);
 
         static inline uint32_t headerSize()
@@ -45,13 +66,36 @@ namespace mwmp
         }
 
     protected:
+        // Read or write count values in one go, which the BitStream copies straight into place when the stream
+        // is at a byte boundary. The bytes are the same as reading or writing each value separately
         template<class templateType>
-        bool RW(templateType &data, uint32_t size, bool write)
+        bool RW(templateType *data, uint32_t count, bool write)
         {
+            static_assert(std::is_trivially_copyable<templateType>::value, "Only plain values can be copied in bulk");
+
+            if (count == 0)
+                return true;
+
+#ifndef __BITSTREAM_NATIVE_END
+            // Values wider than a byte get their bytes reversed one by one on this machine
+            if (sizeof(templateType) > 1 && RakNet::BitStream::DoEndianSwap())
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (!RW(data[i], write))
+                        return false;
+                }
+
+                return true;
+            }
+#endif
+
+            const unsigned int size = static_cast<unsigned int>(count * sizeof(templateType));
+
             if (write)
-                bs->Write(data, size);
+                bs->Write(reinterpret_cast<const char *>(data), size);
             else
-                return bs->Read(data, size);
+                return bs->Read(reinterpret_cast<char *>(data), size);
             return true;
         }
 
@@ -84,6 +128,9 @@ namespace mwmp
             return true;
         }
 
+        // Write the type of a position update and, unless it is a full update, its quantized values
+        bool RW(PositionUpdate &update, bool write);
+
         const static uint32_t maxStrSize = 64 * 1024; // 64 KiB
 
         bool RW(std::string &str, bool write, bool compress = false, std::string::size_type maxSize = maxStrSize)
@@ -128,6 +175,13 @@ namespace mwmp
         RakNet::RakPeerInterface *peer;
         RakNet::RakNetGUID guid;
         bool packetValid;
+
+    private:
+        uint32_t SendData(const char *data, unsigned int length, PacketPriority sendPriority,
+            PacketReliability sendReliability, RakNet::AddressOrGUID destination, bool broadcast);
+
+        PacketBatcher *batcher;
+        static SendObserver sendObserver;
     };
 }
 
@@ -82,8 +82,7 @@ void mwmp::PacketPreInit::Packet(RakNet::BitStream *newBitstream, bool send)
         RW(checksum.first, send, false, numberOfHashesIt->strSize);
 
         checksum.second.resize(numberOfHashesIt->hashN);
-        for (auto &&hash : checksum.second)
-            RW(hash, send);
+        RW(checksum.second.data(), static_cast<uint32_t>(checksum.second.size()), send);
         ++numberOfHashesIt;
     }
 }
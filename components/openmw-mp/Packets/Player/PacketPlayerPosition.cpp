@@ -14,6 +14,16 @@ void PacketPlayerPosition::Packet(RakNet::BitStream *newBitstream, bool send)
 {
     PlayerPacket::Packet(newBitstream, send);
 
-    RW(player->position, send, 1);
-    RW(player->direction, send, 1);
+    if (!RW(player->positionUpdate, send))
+    {
+        packetValid = false;
+        return;
+    }
+
+    // Keyframes and deltas only carry quantized values that the receiving stream turns back into a position
+    if (player->positionUpdate.type == PositionUpdate::FULL)
+    {
+        RW(player->position, send, 1);
+        RW(player->direction, send, 1);
+    }
 }
@@ -19,4 +19,6 @@ void PacketSystemHandshake::Packet(RakNet::BitStream *newBitstream, bool send)
         packetValid = false;
         return;
     }
+
+    RW(system->positionEncodings, send);
 }
@@ -52,9 +52,6 @@ void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
             mapTile.imageData.resize(imageDataSize);
         }
 
-        for (auto &&imageChar : mapTile.imageData)
-        {
-            RW(imageChar, send);
-        }
+        RW(mapTile.imageData.data(), imageDataSize, send);
     }
 }
@@ -0,0 +1,270 @@
+#include "SnapshotBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace mwmp;
+
+namespace
+{
+    // Seconds it takes for half of an error to be corrected
+    const double correctionHalfLife = 0.1;
+    // How quickly the smallest offset seen between the sender's clock and ours is allowed to grow, in
+    // seconds per second, so it can follow clocks drifting apart and routes getting slower
+    const double clockDrift = 0.002;
+    // Stamps of senders not heard from for this long could have wrapped around, so the clocks get matched again
+    const double maxSenderSilence = 30.0;
+    // Seconds that the time a position took to arrive can plausibly change by, beyond which the stamps must
+    // come from a different clock, so the clocks get matched again
+    const double maxClockJump = 1.0;
+    // Positions further apart than this in time say too little about the velocity in between to extrapolate with
+    const double maxExtrapolationSpan = 0.5;
+
+    const double pi = 3.14159265358979323846;
+
+    // Moving the shorter way around
+    float interpolateAngle(float from, float to, double t)
+    {
+        double difference = std::remainder(static_cast<double>(to) - from, 2 * pi);
+        return static_cast<float>(from + difference * t);
+    }
+
+    bool isMoving(const ESM::Position &direction)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            if (!std::isnan(direction.pos[i]) && direction.pos[i] != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    float getDistance(const ESM::Position &position, const ESM::Position &otherPosition)
+    {
+        float x = position.pos[0] - otherPosition.pos[0];
+        float y = position.pos[1] - otherPosition.pos[1];
+        float z = position.pos[2] - otherPosition.pos[2];
+
+        return std::sqrt(x * x + y * y + z * z);
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer() : interpolationDelay(0.1f), extrapolationLimit(0.25f), snapDistance(512.0f),
+    correction{0, 0, 0}, correctionTime(0), hasSenderClock(false), lastSenderTime(0), senderClock(0), clockOffset(0),
+    clockOffsetTime(0)
+{
+
+}
+
+void SnapshotBuffer::setInterpolationDelay(float seconds)
+{
+    interpolationDelay = std::max(seconds, 0.0f);
+}
+
+void SnapshotBuffer::setExtrapolationLimit(float seconds)
+{
+    extrapolationLimit = std::max(seconds, 0.0f);
+}
+
+void SnapshotBuffer::setSnapDistance(float distance)
+{
+    snapDistance = distance;
+}
+
+void SnapshotBuffer::push(double localTime, const ESM::Position &position, const ESM::Position &direction)
+{
+    decayCorrection(localTime);
+    insert(localTime, position, direction);
+}
+
+void SnapshotBuffer::push(double localTime, uint16_t senderTime, const ESM::Position &position,
+    const ESM::Position &direction)
+{
+    bool isClockMatched = hasSenderClock && localTime - clockOffsetTime <= maxSenderSilence;
+
+    if (isClockMatched)
+    {
+        // Stamps only carry the milliseconds since the last time they wrapped around
+        int16_t elapsed = static_cast<int16_t>(static_cast<uint16_t>(senderTime - lastSenderTime));
+        double newSenderClock = senderClock + elapsed / 1000.0;
+        double offset = localTime - newSenderClock;
+
+        if (std::abs(offset - clockOffset) > maxClockJump)
+            isClockMatched = false;
+        else
+        {
+            senderClock = newSenderClock;
+
+            // The position that took the least time to get here is the best guess of when the others were sent
+            clockOffset = std::min(clockOffset + (localTime - clockOffsetTime) * clockDrift, offset);
+        }
+    }
+
+    if (!isClockMatched)
+    {
+        hasSenderClock = true;
+        senderClock = localTime;
+        clockOffset = 0;
+    }
+
+    lastSenderTime = senderTime;
+    clockOffsetTime = localTime;
+
+    decayCorrection(localTime);
+    insert(senderClock + clockOffset, position, direction);
+}
+
+bool SnapshotBuffer::sample(double localTime, ESM::Position &position, ESM::Position &direction)
+{
+    const double renderTime = localTime - interpolationDelay;
+
+    decayCorrection(localTime);
+
+    if (!evaluate(renderTime, position, direction))
+        return false;
+
+    // Only keep a single position from before the one being shown, to interpolate from
+    while (snapshots.size() > 2 && snapshots[1].time <= renderTime)
+        snapshots.pop_front();
+
+    for (int i = 0; i < 3; i++)
+        position.pos[i] += correction[i];
+
+    return true;
+}
+
+void SnapshotBuffer::clear()
+{
+    clearPositions();
+    hasSenderClock = false;
+}
+
+void SnapshotBuffer::clearPositions()
+{
+    snapshots.clear();
+
+    for (int i = 0; i < 3; i++)
+        correction[i] = 0;
+}
+
+bool SnapshotBuffer::isEmpty() const
+{
+    return snapshots.empty();
+}
+
+double SnapshotBuffer::getTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SnapshotBuffer::insert(double time, const ESM::Position &position, const ESM::Position &direction)
+{
+    // A position this far from the newest one is a teleport, which nothing should be interpolated towards
+    if (!snapshots.empty() && getDistance(snapshots.back().position, position) > snapDistance)
+        clearPositions();
+
+    const double renderTime = correctionTime - interpolationDelay;
+
+    ESM::Position before;
+    ESM::Position after;
+    ESM::Position unusedDirection;
+    bool hadBefore = evaluate(renderTime, before, unusedDirection);
+
+    auto it = std::upper_bound(snapshots.begin(), snapshots.end(), time, [](double value, const Snapshot &snapshot) {
+        return value < snapshot.time;
+    });
+
+    snapshots.insert(it, {time, position, direction});
+
+    if (snapshots.size() > capacity)
+        snapshots.pop_front();
+
+    // Keep showing the same position for now, and correct the difference over time
+    if (hadBefore && evaluate(renderTime, after, unusedDirection))
+    {
+        float length = 0;
+
+        for (int i = 0; i < 3; i++)
+        {
+            correction[i] += before.pos[i] - after.pos[i];
+            length += correction[i] * correction[i];
+        }
+
+        if (std::sqrt(length) > snapDistance)
+        {
+            for (int i = 0; i < 3; i++)
+                correction[i] = 0;
+        }
+    }
+}
+
+bool SnapshotBuffer::evaluate(double renderTime, ESM::Position &position, ESM::Position &direction) const
+{
+    if (snapshots.empty())
+        return false;
+
+    auto next = std::upper_bound(snapshots.begin(), snapshots.end(), renderTime,
+        [](double value, const Snapshot &snapshot) {
+            return value < snapshot.time;
+        });
+
+    if (next == snapshots.begin())
+    {
+        position = next->position;
+        direction = next->direction;
+        return true;
+    }
+
+    if (next == snapshots.end())
+    {
+        const Snapshot &last = snapshots.back();
+        position = last.position;
+        direction = last.direction;
+
+        // Carry on moving the way the newest position was, if its sender said it was still moving
+        if (snapshots.size() >= 2 && isMoving(last.direction))
+        {
+            const Snapshot &previous = snapshots[snapshots.size() - 2];
+            double span = last.time - previous.time;
+
+            if (span > 0.001 && span <= maxExtrapolationSpan)
+            {
+                double ahead = std::min(renderTime - last.time, static_cast<double>(extrapolationLimit));
+
+                for (int i = 0; i < 3; i++)
+                    position.pos[i] += static_cast<float>((last.position.pos[i] - previous.position.pos[i]) / span * ahead);
+            }
+        }
+
+        return true;
+    }
+
+    const Snapshot &previous = *(next - 1);
+    double span = next->time - previous.time;
+    double t = span > 0 ? (renderTime - previous.time) / span : 1.0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        position.pos[i] = static_cast<float>(previous.position.pos[i] + (next->position.pos[i] - previous.position.pos[i]) * t);
+        position.rot[i] = interpolateAngle(previous.position.rot[i], next->position.rot[i], t);
+    }
+
+    direction = previous.direction;
+    return true;
+}
+
+void SnapshotBuffer::decayCorrection(double localTime)
+{
+    double elapsed = localTime - correctionTime;
+    correctionTime = localTime;
+
+    if (elapsed <= 0)
+        return;
+
+    float factor = static_cast<float>(std::pow(0.5, elapsed / correctionHalfLife));
+
+    for (int i = 0; i < 3; i++)
+        correction[i] *= factor;
+}
@@ -0,0 +1,85 @@
+#ifndef OPENMW_SNAPSHOTBUFFER_HPP
+#define OPENMW_SNAPSHOTBUFFER_HPP
+
+#include <cstdint>
+#include <deque>
+
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    /*
+        Recent positions of a player or actor controlled by someone else, shown a short delay behind the
+        newest one so there are usually two of them to interpolate between
+
+        Positions stamped by their sender are placed on the local clock through the smallest difference
+        seen between the two clocks, so uneven arrival times don't make movement uneven. Positions
+        without a stamp are placed at their arrival time.
+
+        When no newer position has arrived in time, movement carries on for a while with the velocity of
+        the last two positions. Whatever that got wrong, or any other sudden change in where the entity
+        should be, is corrected over a short time instead of all at once, unless it is far enough away to
+        be a teleport.
+    */
+    class SnapshotBuffer
+    {
+    public:
+        static const unsigned int capacity = 32;
+
+        SnapshotBuffer();
+
+        // Seconds behind the newest position that positions are shown at
+        void setInterpolationDelay(float seconds);
+        // Seconds that movement is carried on for after the newest position
+        void setExtrapolationLimit(float seconds);
+        // Errors larger than this many units are not corrected over time, and snap instead
+        void setSnapDistance(float distance);
+
+        // Add a position that arrived at localTime, in seconds on the clock of getTime()
+        void push(double localTime, const ESM::Position &position, const ESM::Position &direction);
+        // Add a position sent at senderTime, in wrapping milliseconds on the sender's clock
+        void push(double localTime, uint16_t senderTime, const ESM::Position &position, const ESM::Position &direction);
+
+        // Get the position and direction to show at localTime, returning false if there are none yet
+        bool sample(double localTime, ESM::Position &position, ESM::Position &direction);
+
+        // Forget every position, and the sender's clock along with them, such as when a different sender takes over
+        void clear();
+        bool isEmpty() const;
+
+        // Seconds on a steady clock, for the local times passed to the other methods
+        static double getTime();
+
+    private:
+        struct Snapshot
+        {
+            double time;
+            ESM::Position position;
+            ESM::Position direction;
+        };
+
+        void clearPositions();
+        void insert(double time, const ESM::Position &position, const ESM::Position &direction);
+        bool evaluate(double renderTime, ESM::Position &position, ESM::Position &direction) const;
+        void decayCorrection(double localTime);
+
+        std::deque<Snapshot> snapshots;
+
+        float interpolationDelay;
+        float extrapolationLimit;
+        float snapDistance;
+
+        // Offset added to what is shown, shrinking over time
+        float correction[3];
+        double correctionTime;
+
+        // The sender's clock, unwrapped, and its smallest known offset from the local clock
+        bool hasSenderClock;
+        uint16_t lastSenderTime;
+        double senderClock;
+        double clockOffset;
+        double clockOffsetTime;
+    };
+}
+
+#endif //OPENMW_SNAPSHOTBUFFER_HPP
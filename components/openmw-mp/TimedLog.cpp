@@ -1,25 +1,203 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <iostream>
 #include <cstring>
 #include <ctime>
 #include <cstdio>
-#include <sstream>
-#include <vector>
-#include <boost/lexical_cast.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include "TimedLog.hpp"
 
+/*
+    Bounded multiple producer, single consumer queue of log lines, written out by its own thread
+
+    Every slot carries a sequence number telling producers and the consumer whose turn it is, so
+    printing a line only takes an atomic increment and never waits for the thread doing the writing.
+*/
+class TimedLog::Writer
+{
+public:
+    // Must be a power of two
+    static const size_t capacity = 4096;
+    static const size_t maxBatchSize = 64 * 1024;
+
+    Writer() : slots(new Slot[capacity]), enqueuePos(0), dequeuePos(0), writtenPos(0), droppedLines(0),
+        sleeping(false), stopping(false)
+    {
+        for (size_t i = 0; i < capacity; i++)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+
+        thread = std::thread(&Writer::run, this);
+    }
+
+    ~Writer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        wake.notify_one();
+        thread.join();
+    }
+
+    // Returns false if the queue is full, in which case the line is dropped
+    bool push(const char *line, size_t length)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        while (true)
+        {
+            slot = &slots[pos & (capacity - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t) sequence - (intptr_t) pos;
+
+            if (difference == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                droppedLines.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+                pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+
+        slot->line.assign(line, length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        if (sleeping.load(std::memory_order_relaxed))
+            wake.notify_one();
+
+        return true;
+    }
+
+    void flush()
+    {
+        const size_t target = enqueuePos.load(std::memory_order_acquire);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.notify_one();
+        written.wait(lock, [&] { return writtenPos.load(std::memory_order_acquire) >= target; });
+    }
+
+    uint64_t getDroppedLines() const
+    {
+        return droppedLines.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        // Keeps its capacity between lines, so only unusually long lines allocate
+        std::string line;
+    };
+
+    bool hasPending() const
+    {
+        const Slot &slot = slots[dequeuePos & (capacity - 1)];
+        return slot.sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+    }
+
+    void run()
+    {
+        std::string batch;
+        batch.reserve(maxBatchSize);
+        uint64_t reportedDrops = 0;
+
+        while (true)
+        {
+            batch.clear();
+
+            while (batch.size() < maxBatchSize && hasPending())
+            {
+                Slot &slot = slots[dequeuePos & (capacity - 1)];
+                batch += slot.line;
+                slot.sequence.store(dequeuePos + capacity, std::memory_order_release);
+                dequeuePos++;
+            }
+
+            uint64_t drops = droppedLines.load(std::memory_order_relaxed);
+
+            if (drops != reportedDrops)
+            {
+                batch += "[TimedLog] " + std::to_string(drops - reportedDrops) +
+                    " lines were dropped because logging could not keep up\n";
+                reportedDrops = drops;
+            }
+
+            if (!batch.empty())
+            {
+                std::cout.write(batch.data(), batch.size());
+                std::cout.flush();
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    writtenPos.store(dequeuePos, std::memory_order_release);
+                }
+
+                written.notify_all();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+
+            if (hasPending())
+                continue;
+            else if (stopping)
+                break;
+
+            // Producers only notify while this is set, and the timeout covers a notification that
+            // arrives just before the wait starts
+            sleeping.store(true, std::memory_order_relaxed);
+            wake.wait_for(lock, std::chrono::milliseconds(100), [&] { return stopping || hasPending(); });
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> enqueuePos;
+    // Only used by the writing thread
+    size_t dequeuePos;
+    std::atomic<size_t> writtenPos;
+    std::atomic<uint64_t> droppedLines;
+
+    std::atomic<bool> sleeping;
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    std::thread thread;
+};
+
 TimedLog *TimedLog::sTimedLog = nullptr;
 
-TimedLog::TimedLog(int logLevel) : logLevel(logLevel)
+TimedLog::TimedLog(int logLevel, bool asynchronous) : logLevel(logLevel), writer(nullptr)
 {
+    if (asynchronous)
+        writer = new Writer();
+}
 
+TimedLog::~TimedLog()
+{
+    delete writer;
 }
 
-void TimedLog::Create(int logLevel)
+void TimedLog::Create(int logLevel, bool asynchronous)
 {
     if (sTimedLog != nullptr)
         return;
-    sTimedLog = new TimedLog(logLevel);
+    sTimedLog = new TimedLog(logLevel, asynchronous);
 }
 
 void TimedLog::Delete()
@@ -45,64 +223,129 @@ void TimedLog::SetLevel(int level)
     sTimedLog->logLevel = level;
 }
 
+void TimedLog::Flush()
+{
+    if (sTimedLog != nullptr && sTimedLog->writer != nullptr)
+        sTimedLog->writer->flush();
+}
+
+uint64_t TimedLog::GetDroppedLines()
+{
+    if (sTimedLog == nullptr || sTimedLog->writer == nullptr)
+        return 0;
+
+    return sTimedLog->writer->getDroppedLines();
+}
+
+// Only formats the time again once the second changes, separately for every thread
 const char* getTime()
 {
+    thread_local time_t cachedTime = -1;
+    thread_local char result[20];
+
     time_t t = time(0);
-    struct tm *tm = localtime(&t);
-    static char result[20];
-    sprintf(result, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d",
-            1900 + tm->tm_year, tm->tm_mon + 1, tm->tm_mday,
-            tm->tm_hour, tm->tm_min, tm->tm_sec);
+
+    if (t != cachedTime)
+    {
+        struct tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        strftime(result, sizeof(result), "%Y-%m-%d %H:%M:%S", &tm);
+        cachedTime = t;
+    }
+
     return result;
 }
 
 void TimedLog::print(int level, bool hasPrefix, const char *file, int line, const char *message, ...) const
 {
     if (level < logLevel) return;
-    std::stringstream sstr;
+
+    char buffer[1024];
+    size_t length = 0;
 
     if (hasPrefix)
     {
+        const char *levelName;
 
-        sstr << "[" << getTime() << "] ";
-
-        if (file != 0 && line != 0)
-        {
-            sstr << "[" << file << ":";
-            sstr << line << "] ";
-        }
-
-        sstr << "[";
         switch (level)
         {
         case LOG_WARN:
-            sstr << "WARN";
+            levelName = "WARN";
             break;
         case LOG_ERROR:
-            sstr << "ERR";
+            levelName = "ERR";
             break;
         case LOG_FATAL:
-            sstr << "FATAL";
+            levelName = "FATAL";
             break;
         default:
-            sstr << "INFO";
+            levelName = "INFO";
         }
-        sstr << "]: ";
 
+        int prefixLength;
+
+        if (file != 0 && line != 0)
+            prefixLength = snprintf(buffer, sizeof(buffer), "[%s] [%s:%d] [%s]: ", getTime(), file, line, levelName);
+        else
+            prefixLength = snprintf(buffer, sizeof(buffer), "[%s] [%s]: ", getTime(), levelName);
+
+        if (prefixLength > 0)
+            length = std::min((size_t) prefixLength, sizeof(buffer) - 1);
     }
 
-    sstr << message;
-    char back = *sstr.str().rbegin();
-    if (back != '\n')
-        sstr << '\n';
     va_list args;
     va_start(args, message);
-    std::vector<char> buf((unsigned long) (vsnprintf(nullptr, 0, sstr.str().c_str(), args) + 1));
-    va_end(args);
-    va_start(args, message);
-    vsnprintf(buf.data(), buf.size(), sstr.str().c_str(), args);
+    int messageLength = vsnprintf(buffer + length, sizeof(buffer) - length, message, args);
     va_end(args);
-    std::cout << buf.data() << std::flush;
+
+    if (messageLength < 0)
+        messageLength = 0;
+
+    char *text = buffer;
+    std::string longText;
+
+    // Keep room for a newline after the message
+    if (length + messageLength + 1 < sizeof(buffer))
+        length += messageLength;
+    else
+    {
+        longText.assign(buffer, length);
+        longText.resize(length + messageLength + 1);
+
+        va_start(args, message);
+        vsnprintf(&longText[length], messageLength + 1, message, args);
+        va_end(args);
+
+        length += messageLength;
+        longText.resize(length + 1);
+        text = &longText[0];
+    }
+
+    char *end = text + length;
+
+    if (length == 0 || end[-1] != '\n')
+    {
+        end[0] = '\n';
+        length++;
+    }
+
+    if (writer != nullptr)
+    {
+        writer->push(text, length);
+
+        // Make sure the reason for a crash gets written before it happens
+        if (level >= LOG_FATAL)
+            writer->flush();
+    }
+    else
+    {
+        std::cout.write(text, length);
+        std::cout.flush();
+    }
 }
 
 std::string TimedLog::getFilenameTimestamp()
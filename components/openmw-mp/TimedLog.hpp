@@ -1,6 +1,8 @@
 #ifndef OPENMW_LOG_HPP
 #define OPENMW_LOG_HPP
 
+#include <cstdint>
+
 #include <boost/filesystem.hpp>
 
 #ifdef __GNUC__
@@ -9,11 +11,13 @@
 
 #if defined(NOLOGS)
 #define LOG_INIT(logLevel)
+#define LOG_INIT_ASYNC(logLevel)
 #define LOG_QUIT()
 #define LOG_MESSAGE(level, msg, ...)
 #define LOG_MESSAGE_SIMPLE(level, msg, ...)
 #else
 #define LOG_INIT(logLevel) TimedLog::Create(logLevel)
+#define LOG_INIT_ASYNC(logLevel) TimedLog::Create(logLevel, true)
 #define LOG_QUIT() TimedLog::Delete()
 #if defined(_MSC_VER)
 #define LOG_MESSAGE(level, msg, ...) TimedLog::Get().print((level), (1), (__FILE__), (__LINE__), (msg), __VA_ARGS__)
@@ -37,22 +41,33 @@ public:
         LOG_ERROR,
         LOG_FATAL
     };
-    static void Create(int logLevel);
+    /// With asynchronous set, lines are handed to a background thread that writes them to std::cout
+    /// in batches, and lines that do not fit in its queue are dropped instead of waiting for it
+    static void Create(int logLevel, bool asynchronous = false);
     static void Delete();
     static const TimedLog &Get();
     static int GetLevel();
     static void SetLevel(int level);
     void print(int level, bool hasPrefix, const char *file, int line, const char *message, ...) const;
 
+    /// Wait until every line printed so far has been written
+    static void Flush();
+    /// Number of lines dropped because the background thread could not keep up
+    static uint64_t GetDroppedLines();
+
     static std::string getFilenameTimestamp();
 private:
-    TimedLog(int logLevel);
+    class Writer;
+
+    TimedLog(int logLevel, bool asynchronous);
+    ~TimedLog();
     /// Not implemented
     TimedLog(const TimedLog &) = delete;
     /// Not implemented
     TimedLog &operator=(TimedLog &) = delete;
     static TimedLog *sTimedLog;
     int logLevel;
+    Writer *writer;
 };
 
 
@@ -7,7 +7,6 @@
 #include <memory>
 #include <iostream>
 #include <sstream>
-#include <boost/crc.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <iomanip>
 
@@ -156,21 +155,86 @@ long int Utils::getFileLength(const char* file)
     return size;
 }
 
+namespace
+{
+    // Tables for going through the data 8 bytes at a time, where tables[k] handles a byte followed by k others
+    struct Crc32Tables
+    {
+        uint32_t tables[8][256];
+
+        Crc32Tables()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+
+                for (int bit = 0; bit < 8; bit++)
+                    crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+
+                tables[0][i] = crc;
+            }
+
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                for (int k = 1; k < 8; k++)
+                    tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+            }
+        }
+    };
+
+    inline uint32_t readLittleEndian(const unsigned char *bytes)
+    {
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+    }
+}
+
+unsigned int Utils::crc32(unsigned int crc, const void *data, size_t length)
+{
+    static const Crc32Tables crc32Tables;
+    const uint32_t (&tables)[8][256] = crc32Tables.tables;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint32_t value = ~crc;
+
+    while (length >= 8)
+    {
+        uint32_t low = value ^ readLittleEndian(bytes);
+        uint32_t high = readLittleEndian(bytes + 4);
+
+        value = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^
+            tables[4][low >> 24] ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+            tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+
+        bytes += 8;
+        length -= 8;
+    }
+
+    while (length-- != 0)
+        value = tables[0][(value ^ *bytes++) & 0xFF] ^ (value >> 8);
+
+    return ~value;
+}
+
 unsigned int ::Utils::crc32Checksum(const std::string &file)
 {
-    boost::crc_32_type  crc32;
-    boost::filesystem::ifstream  ifs(file, std::ios_base::binary);
+    // Data files are often hundreds of megabytes, so read them in large pieces
+    const std::streamsize bufferSize = 1024 * 1024;
+
+    unsigned int checksum = 0;
+    boost::filesystem::ifstream ifs(file, std::ios_base::binary);
+
     if (ifs)
     {
+        std::unique_ptr<char[]> buffer(new char[bufferSize]);
+
         do
         {
-            char buffer[1024];
-
-            ifs.read(buffer, 1024);
-            crc32.process_bytes( buffer, ifs.gcount() );
+            ifs.read(buffer.get(), bufferSize);
+            checksum = crc32(checksum, buffer.get(), ifs.gcount());
         } while (ifs);
     }
-    return crc32.checksum();
+
+    return checksum;
 }
 
 std::string Utils::getOperatingSystemType()
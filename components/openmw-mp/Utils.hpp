@@ -2,6 +2,7 @@
 #define UTILS_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -54,6 +55,8 @@ namespace Utils
 
     long int getFileLength(const char *file);
 
+    // Continue a CRC-32, the same one as boost::crc_32_type, over more data, starting from 0
+    unsigned int crc32(unsigned int crc, const void *data, size_t length);
     unsigned int crc32Checksum(const std::string &file);
 
     std::string getOperatingSystemType();